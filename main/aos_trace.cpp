@@ -0,0 +1,28 @@
+#include <cstdio>
+#include <exception>
+#include <iostream>
+
+#include "flowshop-solver/aos/aos_trace.hpp"
+
+/**
+ * Prints an AOS trace written with --aosTrace as CSV.
+ *
+ * usage: aos_trace <trace file>
+ */
+auto main(int argc, char* argv[]) -> int {
+  if (argc < 2) {
+    std::cerr << "usage: aos_trace <trace file>\n";
+    return 1;
+  }
+  try {
+    std::puts("time,arm,reward,fitness");
+    readAOSTrace(argv[1], [](const AOSTraceEvent& event) {
+      std::printf("%.6f,%d,%.17g,%.17g\n", event.time * 1e-6, event.arm,
+                  event.reward, event.fitness);
+    });
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
@@ -115,6 +115,64 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// enumerateAllFitnessHistogram
+DataFrame enumerateAllFitnessHistogram(Rcpp::CharacterVector rproblem, int threads);
+RcppExport SEXP _FlowshopSolveR_enumerateAllFitnessHistogram(SEXP rproblemSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::CharacterVector >::type rproblem(rproblemSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(enumerateAllFitnessHistogram(rproblem, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// enumerateAllFitnessToFile
+double enumerateAllFitnessToFile(Rcpp::CharacterVector rproblem, std::string filename, int threads);
+RcppExport SEXP _FlowshopSolveR_enumerateAllFitnessToFile(SEXP rproblemSEXP, SEXP filenameSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::CharacterVector >::type rproblem(rproblemSEXP);
+    Rcpp::traits::input_parameter< std::string >::type filename(filenameSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(enumerateAllFitnessToFile(rproblem, filename, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// readFitnessFileValues
+NumericVector readFitnessFileValues(std::string filename);
+RcppExport SEXP _FlowshopSolveR_readFitnessFileValues(SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type filename(filenameSEXP);
+    rcpp_result_gen = Rcpp::wrap(readFitnessFileValues(filename));
+    return rcpp_result_gen;
+END_RCPP
+}
+// readAOSTraceEvents
+DataFrame readAOSTraceEvents(std::string filename);
+RcppExport SEXP _FlowshopSolveR_readAOSTraceEvents(SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type filename(filenameSEXP);
+    rcpp_result_gen = Rcpp::wrap(readAOSTraceEvents(filename));
+    return rcpp_result_gen;
+END_RCPP
+}
+// fspInstanceFeatures
+NumericVector fspInstanceFeatures(std::string filename);
+RcppExport SEXP _FlowshopSolveR_fspInstanceFeatures(SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type filename(filenameSEXP);
+    rcpp_result_gen = Rcpp::wrap(fspInstanceFeatures(filename));
+    return rcpp_result_gen;
+END_RCPP
+}
 // enumerateSolutions
 List enumerateSolutions(Rcpp::List fspInstance, Rcpp::CharacterVector fspProblem);
 RcppExport SEXP _FlowshopSolveR_enumerateSolutions(SEXP fspInstanceSEXP, SEXP fspProblemSEXP) {
@@ -127,6 +185,20 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// enumerateNearOptimalSolutions
+List enumerateNearOptimalSolutions(Rcpp::List fspInstance, Rcpp::CharacterVector fspProblem, long tolerance, int threads);
+RcppExport SEXP _FlowshopSolveR_enumerateNearOptimalSolutions(SEXP fspInstanceSEXP, SEXP fspProblemSEXP, SEXP toleranceSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::List >::type fspInstance(fspInstanceSEXP);
+    Rcpp::traits::input_parameter< Rcpp::CharacterVector >::type fspProblem(fspProblemSEXP);
+    Rcpp::traits::input_parameter< long >::type tolerance(toleranceSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(enumerateNearOptimalSolutions(fspInstance, fspProblem, tolerance, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // sampleLON
 List sampleLON(std::string sampleType, Rcpp::CharacterVector rproblem, Rcpp::CharacterVector rsampling, long seed);
 RcppExport SEXP _FlowshopSolveR_sampleLON(SEXP sampleTypeSEXP, SEXP rproblemSEXP, SEXP rsamplingSEXP, SEXP seedSEXP) {
@@ -151,7 +223,13 @@ static const R_CallMethodDef CallEntries[] = {
     {"_FlowshopSolveR_adaptiveWalk", (DL_FUNC) &_FlowshopSolveR_adaptiveWalk, 3},
     {"_FlowshopSolveR_adaptiveWalkLengthFLA", (DL_FUNC) &_FlowshopSolveR_adaptiveWalkLengthFLA, 3},
     {"_FlowshopSolveR_enumerateAllFitness", (DL_FUNC) &_FlowshopSolveR_enumerateAllFitness, 1},
+    {"_FlowshopSolveR_enumerateAllFitnessHistogram", (DL_FUNC) &_FlowshopSolveR_enumerateAllFitnessHistogram, 2},
+    {"_FlowshopSolveR_enumerateAllFitnessToFile", (DL_FUNC) &_FlowshopSolveR_enumerateAllFitnessToFile, 3},
+    {"_FlowshopSolveR_readFitnessFileValues", (DL_FUNC) &_FlowshopSolveR_readFitnessFileValues, 1},
+    {"_FlowshopSolveR_readAOSTraceEvents", (DL_FUNC) &_FlowshopSolveR_readAOSTraceEvents, 1},
+    {"_FlowshopSolveR_fspInstanceFeatures", (DL_FUNC) &_FlowshopSolveR_fspInstanceFeatures, 1},
     {"_FlowshopSolveR_enumerateSolutions", (DL_FUNC) &_FlowshopSolveR_enumerateSolutions, 2},
+    {"_FlowshopSolveR_enumerateNearOptimalSolutions", (DL_FUNC) &_FlowshopSolveR_enumerateNearOptimalSolutions, 4},
     {"_FlowshopSolveR_sampleLON", (DL_FUNC) &_FlowshopSolveR_sampleLON, 4},
     {NULL, NULL, 0}
 };
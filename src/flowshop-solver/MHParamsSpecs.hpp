@@ -51,6 +51,10 @@ class MHParamsSpecs {
   auto noRealParams() const -> int { return noParams(ParamSpec::Type::REAL); }
   auto noNumParams() const -> int { return noIntParams() + noRealParams(); }
 
+  auto contains(const std::string& s) const -> bool {
+    return params_map.find(s) != params_map.end();
+  }
+
   auto getIdx(const std::string& s) const -> int {
     if (params_map.find(s) == params_map.end())
       throw std::runtime_error("Unknown parameter " + s + "\n");
@@ -43,6 +43,18 @@ class MHParamsValues : public eoReal<eoMaximizingFitness> {
     return paramSpec->toStrValue(static_cast<float>(categorical(s)));
   }
 
+  /**
+   * Value of an optional categorical parameter, or `def` when it is not part
+   * of the specification or has no value.
+   */
+  [[nodiscard]] auto categoricalName(const std::string& s,
+                                     const std::string& def) const
+      -> std::string {
+    if (!specs->contains(s) || (*this)[s] < 0)
+      return def;
+    return categoricalName(s);
+  }
+
   [[nodiscard]] auto integer(const std::string& s) const -> int {
     if (!specs->isInteger(s))
       throw std::runtime_error("Parameter " + s + " is not integer");
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <fstream>
+#include <istream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Decision tree trained offline that picks parameter values, such as the
+ * destruction size or the AOS strategy, from instance features. Files are
+ * written by write_policy_tree() in R, with one node per line in preorder:
+ *
+ *   split <feature> < <threshold>     instances with feature < threshold go
+ *   split <feature> >= <threshold>    to the first subtree, others to the
+ *                                     second one
+ *   leaf <parameter>=<value> ...
+ *
+ * Empty lines and lines starting with # are ignored.
+ */
+class ParamsPolicy {
+ public:
+  using Values = std::vector<std::pair<std::string, std::string>>;
+
+ private:
+  struct Node {
+    std::string feature;
+    bool lessThan = true;
+    double threshold = 0.0;
+    int first = -1;
+    int second = -1;
+    Values values;
+  };
+
+  std::vector<Node> nodes;
+
+  static auto nextLine(std::istream& is) -> std::string {
+    std::string line;
+    while (std::getline(is, line)) {
+      const auto start = line.find_first_not_of(" \t\r");
+      if (start != std::string::npos && line[start] != '#')
+        return line;
+    }
+    throw std::runtime_error("Policy tree ended before its last leaf");
+  }
+
+  /** Reads the subtree starting at the next line, returns its root. */
+  auto readNode(std::istream& is) -> int {
+    std::istringstream line(nextLine(is));
+    std::string kind;
+    line >> kind;
+    const int index = nodes.size();
+    nodes.emplace_back();
+    if (kind == "leaf") {
+      std::string assignment;
+      while (line >> assignment) {
+        const auto equals = assignment.find('=');
+        if (equals == std::string::npos)
+          throw std::runtime_error("Invalid policy value: " + assignment);
+        nodes[index].values.emplace_back(assignment.substr(0, equals),
+                                         assignment.substr(equals + 1));
+      }
+      return index;
+    }
+    std::string op;
+    line >> nodes[index].feature >> op >> nodes[index].threshold;
+    if (kind != "split" || !line || (op != "<" && op != ">="))
+      throw std::runtime_error("Invalid policy node: " + line.str());
+    nodes[index].lessThan = op == "<";
+    const int first = readNode(is);
+    const int second = readNode(is);
+    nodes[index].first = first;
+    nodes[index].second = second;
+    return index;
+  }
+
+ public:
+  explicit ParamsPolicy(std::istream& is) { readNode(is); }
+
+  explicit ParamsPolicy(const std::string& filename) {
+    std::ifstream is(filename);
+    if (!is)
+      throw std::runtime_error("Policy file " + filename + " not found!");
+    readNode(is);
+  }
+
+  /** Values of the leaf reached by the features. */
+  [[nodiscard]] auto predict(const std::map<std::string, double>& features)
+      const -> const Values& {
+    int at = 0;
+    while (nodes[at].first >= 0) {
+      const Node& node = nodes[at];
+      const auto feature = features.find(node.feature);
+      if (feature == features.end())
+        throw std::runtime_error("Policy uses unknown feature " +
+                                 node.feature);
+      const bool less = feature->second < node.threshold;
+      at = less == node.lessThan ? node.first : node.second;
+    }
+    return nodes[at].values;
+  }
+
+  /** Adds the predicted values of the parameters that have no value. */
+  void apply(const std::map<std::string, double>& features,
+             std::unordered_map<std::string, std::string>& params) const {
+    for (const auto& [name, value] : predict(features))
+      params.emplace(name, value);
+  }
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * SplitMix64 finalizer (Steele, Lea and Flood 2014), used to derive
+ * well-mixed 64-bit keys from small integers.
+ */
+inline auto splitMix64(uint64_t x) -> uint64_t {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30u)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27u)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31u);
+}
+
+/**
+ * Key of job `job` placed at position `position` in a Zobrist hash of a
+ * permutation.
+ */
+inline auto jobPositionKey(unsigned job, unsigned position) -> uint64_t {
+  return splitMix64((static_cast<uint64_t>(job) << 32u) | position);
+}
+
+/**
+ * Zobrist hash of a (possibly partial) permutation: xor of the keys of
+ * every job/position pair.
+ */
+template <class EOT>
+auto permutationHash(const EOT& sol) -> uint64_t {
+  uint64_t hash = 0;
+  for (unsigned i = 0; i < sol.size(); i++)
+    hash ^= jobPositionKey(sol[i], i);
+  return hash;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include <paradiseo/eo/eo>
 
 class RunOptions {
@@ -8,6 +10,12 @@ class RunOptions {
   bool printFitnessReward = false;
   bool printDestructionChoices = false;
   bool printLastFitness = false;
+  bool printVisitedStats = false;
+  bool printRestartTimes = false;
+  std::string aosTrace;
+  std::string aosState;
+  bool aosWarmStart = false;
+  std::string policy;
 
   RunOptions() = default;
 
@@ -27,7 +35,32 @@ class RunOptions {
         printLastFitness{createParam(parser,
                                      false,
                                      "printLastFitness",
-                                     "print final result")} {}
+                                     "print final result")},
+        printVisitedStats{createParam(parser,
+                                      false,
+                                      "printVisitedStats",
+                                      "print IG visited solutions filter hits")},
+        printRestartTimes{createParam(parser,
+                                      false,
+                                      "printRestartTimes",
+                                      "print ISA restart setup/search times")},
+        aosTrace{createParam(parser,
+                             std::string(),
+                             "aosTrace",
+                             "binary file to trace AOS decisions to")},
+        aosState{createParam(parser,
+                             std::string(),
+                             "aosState",
+                             "file to save learned AOS states to")},
+        aosWarmStart{createParam(parser,
+                                 false,
+                                 "aosWarmStart",
+                                 "start AOS from the states in aosState")},
+        policy{createParam(parser,
+                           std::string(),
+                           "policy",
+                           "decision tree file picking unset parameters "
+                           "from instance features")} {}
 
  private:
   template <class T>
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads running index-parallel loops. The calling thread
+ * takes part in every loop and parallelFor returns once all indices were
+ * processed. The first exception thrown by a task is rethrown to the caller.
+ */
+class ThreadPool {
+  using Task = std::function<void(unsigned)>;
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wakeUp;
+  std::condition_variable done;
+  const Task* task = nullptr;
+  unsigned noTasks = 0;
+  std::atomic<unsigned> nextTask{0};
+  unsigned running = 0;
+  unsigned long generation = 0;
+  bool stopping = false;
+  std::exception_ptr error;
+
+  void runTasks(const Task& f, unsigned n) {
+    for (unsigned i = nextTask++; i < n; i = nextTask++) {
+      try {
+        f(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+
+  void workerLoop() {
+    unsigned long seen = 0;
+    while (true) {
+      const Task* f = nullptr;
+      unsigned n = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeUp.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping)
+          return;
+        seen = generation;
+        f = task;
+        n = noTasks;
+      }
+      runTasks(*f, n);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--running == 0)
+        done.notify_one();
+    }
+  }
+
+ public:
+  explicit ThreadPool(unsigned noThreads) {
+    for (unsigned i = 1; i < noThreads; i++)
+      workers.emplace_back([this] { workerLoop(); });
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  [[nodiscard]] auto size() const -> unsigned { return workers.size() + 1; }
+
+  void parallelFor(unsigned n, const Task& f) {
+    if (workers.empty() || n <= 1) {
+      for (unsigned i = 0; i < n; i++)
+        f(i);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      task = &f;
+      noTasks = n;
+      nextTask = 0;
+      running = workers.size();
+      error = nullptr;
+      generation++;
+    }
+    wakeUp.notify_all();
+    runTasks(f, n);
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return running == 0; });
+    if (error)
+      std::rethrow_exception(error);
+  }
+};
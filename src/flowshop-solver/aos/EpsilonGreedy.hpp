@@ -4,6 +4,7 @@
 #include <cctype>
 #include <iostream>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "flowshop-solver/aos/adaptive_operator_selection.hpp"
@@ -34,6 +35,23 @@ class EpsilonGreedy : public OperatorSelection<OpT> {
     return opIdx;
   }
 
+  void observe(int op, const SharedOperatorRewards::Totals& delta) override {
+    counters[op] += delta.count;
+    rewards[op] += delta.sum;
+  }
+
+  void writeState(std::ostream& os) const override {
+    this->writeValues(os, counters);
+    this->writeValues(os, rewards);
+  }
+
+  auto readState(std::istream& is) -> bool override {
+    auto savedCounters = this->template readValues<int>(is, counters.size());
+    rewards = this->template readValues<double>(is, rewards.size());
+    counters = std::move(savedCounters);
+    return true;
+  }
+
  public:
   EpsilonGreedy(const std::vector<OpT>& operators, const double epsilon)
       : OperatorSelection<OpT>(operators), epsilon(epsilon) {
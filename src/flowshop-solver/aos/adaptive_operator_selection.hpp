@@ -1,10 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 #include <paradiseo/eo/eo>
 
+#include "flowshop-solver/aos/aos_trace.hpp"
+#include "flowshop-solver/aos/operator_cost.hpp"
+#include "flowshop-solver/aos/shared_rewards.hpp"
 #include "flowshop-solver/continuators/myTimeStat.hpp"
 #include "flowshop-solver/global.hpp"
 #include "flowshop-solver/heuristics/falseContinuator.hpp"
@@ -26,9 +31,73 @@ private:
   falseContinuator<DummyNgh> noWarmUp;
   bool warmingUp = true;
 
+  // rewards shared with the AOS of other workers
+  SharedOperatorRewards* shared = nullptr;
+  int sharedWorker = -1;
+  int syncPeriod = 1;
+  int noFeedbacks = 0;
+  int lastSelected = -1;
+  std::vector<SharedOperatorRewards::Totals> merged;
+
+  AOSTraceWriter* tracer = nullptr;
+
+  // effort measure dividing the rewards, with its value at the selection
+  OperatorCost* cost = nullptr;
+  double costAtSelection = 0.0;
+
+  /** Passes the rewards pushed by other workers since the last merge. */
+  void mergeShared() {
+    for (int worker = 0; worker < shared->maxWorkers(); worker++) {
+      if (worker == sharedWorker)
+        continue;
+      for (int op = 0; op < noOperators(); op++) {
+        const auto totals = shared->read(worker, op);
+        auto& last = merged[worker * noOperators() + op];
+        if (totals.count == last.count)
+          continue;
+        observe(op, {totals.sum - last.sum, totals.count - last.count,
+                     totals.positives - last.positives});
+        last = totals;
+      }
+    }
+  }
+
  protected:
   virtual auto selectOperatorIdx() -> int = 0;
 
+  /**
+   * Rewards of operator op given to another worker: `count` rewards adding
+   * up to `sum`, `positives` of them greater than zero. Strategies that
+   * cannot use them ignore them.
+   */
+  virtual void observe(int /* op */,
+                       const SharedOperatorRewards::Totals& /* delta */) {}
+
+  template <class T>
+  static void writeValues(std::ostream& os, const std::vector<T>& values) {
+    for (const T& value : values)
+      os << ' ' << value;
+  }
+
+  template <class T>
+  static auto readValues(std::istream& is, long n) -> std::vector<T> {
+    std::vector<T> values(n);
+    for (T& value : values)
+      is >> value;
+    if (!is)
+      throw std::runtime_error("Invalid AOS state");
+    return values;
+  }
+
+  /** Writes what the strategy learned, as whitespace separated values. */
+  virtual void writeState(std::ostream& /* os */) const {}
+
+  /**
+   * Reads a state written by writeState(), returning false, without changes,
+   * if it is incompatible with this selection.
+   */
+  virtual auto readState(std::istream& /* is */) -> bool { return true; }
+
  public:
   // lifecycle
   OperatorSelection(std::vector<OpT> operators)
@@ -59,16 +128,70 @@ private:
     warmup.init(dummy);
   }
 
+  /**
+   * Shares the feedback with the other workers using `rewards`: every
+   * feedback is pushed to them and, every `period` feedbacks, the ones
+   * pushed by the others are passed to observe().
+   */
+  void share(SharedOperatorRewards& rewards, int period) {
+    shared = &rewards;
+    sharedWorker = rewards.addWorker();
+    syncPeriod = std::max(period, 1);
+    merged.assign(rewards.maxWorkers() * noOperators(), {});
+  }
+
+  /** Records every feedback, with the selected operator, in `writer`. */
+  void trace(AOSTraceWriter& writer) { tracer = &writer; }
+
+  /**
+   * Divides every reward by the effort measured by `measure` since the
+   * operator was selected, so that operators are compared by improvement per
+   * millisecond or evaluation instead of per application.
+   */
+  void chargeCost(OperatorCost& measure) { cost = &measure; }
+
+  [[nodiscard]] auto chargesCost() const -> bool { return cost != nullptr; }
+
+  /** Writes the learned state, to continue from it with restoreState(). */
+  void saveState(std::ostream& os) const {
+    os << noOperators();
+    writeState(os);
+  }
+
+  /**
+   * Continues from a state written by saveState() of a selection built with
+   * the same strategy, skipping the warm-up. Returns false if the state is
+   * incompatible, e.g. has a different number of operators.
+   */
+  auto restoreState(std::istream& is) -> bool {
+    int savedOperators = 0;
+    if (!(is >> savedOperators))
+      throw std::runtime_error("Invalid AOS state");
+    if (savedOperators != noOperators() || !readState(is))
+      return false;
+    warmupContinuator = &noWarmUp;
+    return true;
+  }
+
   // main interface
   virtual void reset(double){};  // on init algorithm
   virtual void doFeedback(double){};
   virtual void update(){};  // on finish generation
   virtual auto printOn(std::ostream& os) -> std::ostream& = 0;
 
-  void feedback(const double reward) {
+  void feedback(double reward) {
     if (warmingUp) 
       return;
+    if (cost != nullptr)
+      reward /= std::max(cost->now() - costAtSelection, cost->resolution());
     doFeedback(reward);
+    if (tracer != nullptr && lastSelected >= 0)
+      tracer->record(lastSelected, reward);
+    if (shared != nullptr && lastSelected >= 0) {
+      shared->push(sharedWorker, lastSelected, reward);
+      if (++noFeedbacks % syncPeriod == 0)
+        mergeShared();
+    }
   } 
 
   auto selectOperator() -> OpT& {
@@ -78,12 +201,15 @@ private:
         case WarmUpStrategy::FIXED:
           return operators[fixedWarmUpParameter];
         case WarmUpStrategy::RANDOM:
-          return rng.choice(operators);
+          return RNG::paradiseo().choice(operators);
       }
     } else {
       warmingUp = false;
     }
     auto op_idx = selectOperatorIdx();
+    lastSelected = op_idx;
+    if (cost != nullptr)
+      costAtSelection = cost->now();
     return operators[op_idx];
   };
 
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flowshop-solver/aos/adaptive_operator_selection.hpp"
+
+/** Exclusive advisory lock on a file, held while the object lives. */
+class FileLock {
+  int fd;
+
+ public:
+  explicit FileLock(const std::string& filename)
+      : fd{::open(filename.c_str(), O_RDWR | O_CREAT, 0644)} {
+    if (fd < 0 || ::flock(fd, LOCK_EX) != 0) {
+      if (fd >= 0)
+        ::close(fd);
+      throw std::runtime_error("Could not lock " + filename);
+    }
+  }
+
+  FileLock(const FileLock&) = delete;
+  auto operator=(const FileLock&) -> FileLock& = delete;
+
+  ~FileLock() {
+    ::flock(fd, LOCK_UN);
+    ::close(fd);
+  }
+};
+
+/**
+ * Learned states of operator selections, kept in a text file with one
+ * "key state" line per selection. Keys name the instance features and the
+ * selection, so that later runs on similar instances can continue from the
+ * learned preferences instead of warming up again.
+ *
+ * Runs may share the file: saves are serialized by a lock on
+ * `filename + ".lock"` and keep the states saved by other runs meanwhile.
+ *
+ * Selections are tracked by reference, so their owner must release them
+ * before destroying them. Their last states are then kept until the next
+ * save().
+ */
+class AOSStateStore {
+  struct Tracked {
+    std::string key;
+    const void* owner;
+    std::function<void(std::ostream&)> write;
+  };
+
+  std::string filename;
+  std::map<std::string, std::string> states;
+  std::map<std::string, std::string> released;
+  std::vector<Tracked> tracked;
+
+  static auto serialize(const Tracked& selection) -> std::string {
+    std::ostringstream os;
+    os.precision(std::numeric_limits<double>::max_digits10);
+    selection.write(os);
+    return os.str();
+  }
+
+  void read() {
+    std::ifstream in(filename);
+    std::string line;
+    while (std::getline(in, line)) {
+      const auto separator = line.find(' ');
+      if (separator != std::string::npos)
+        states[line.substr(0, separator)] = line.substr(separator + 1);
+    }
+  }
+
+ public:
+  /** Reads the states in `filename`, if it exists. */
+  explicit AOSStateStore(std::string filename)
+      : filename{std::move(filename)} {
+    read();
+  }
+
+  /** Continues `aos` from the state stored under `key`, if compatible. */
+  template <class OpT>
+  auto restore(const std::string& key, OperatorSelection<OpT>& aos) -> bool {
+    const auto state = states.find(key);
+    if (state == states.end())
+      return false;
+    std::istringstream is(state->second);
+    return aos.restoreState(is);
+  }
+
+  /**
+   * Stores the state of `aos` under `key` on every save(), until `owner`
+   * releases it.
+   */
+  template <class OpT>
+  void track(const std::string& key,
+             OperatorSelection<OpT>& aos,
+             const void* owner = nullptr) {
+    tracked.push_back(
+        {key, owner, [&aos](std::ostream& os) { aos.saveState(os); }});
+  }
+
+  /** Keeps the current states of the selections of `owner` and forgets them. */
+  void release(const void* owner) {
+    const auto first = std::stable_partition(
+        tracked.begin(), tracked.end(),
+        [owner](const Tracked& selection) { return selection.owner != owner; });
+    for (auto it = first; it != tracked.end(); ++it)
+      released[it->key] = serialize(*it);
+    tracked.erase(first, tracked.end());
+  }
+
+  /**
+   * Rewrites the file with the states of the tracked selections, keeping
+   * the other ones as currently stored. The file is replaced at once, so
+   * that a failed write does not lose the previous states.
+   */
+  void save() {
+    FileLock lock(filename + ".lock");
+    read();
+    for (const auto& [key, state] : released)
+      states[key] = state;
+    for (const auto& selection : tracked)
+      states[selection.key] = serialize(selection);
+    const std::string tmpFilename = filename + ".tmp." +
+                                    std::to_string(::getpid()) + '.' +
+                                    std::to_string(std::random_device{}());
+    {
+      std::ofstream out(tmpFilename);
+      for (const auto& [key, state] : states)
+        out << key << ' ' << state << '\n';
+      if (!out)
+        throw std::runtime_error("Could not write AOS states to " +
+                                 tmpFilename);
+    }
+    if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+      std::remove(tmpFilename.c_str());
+      throw std::runtime_error("Could not write AOS states to " + filename);
+    }
+  }
+};
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <paradiseo/mo/mo>
+
+struct AOSTraceEvent {
+  // microseconds since the trace was opened
+  std::int64_t time;
+  // selected operator, -1 for the number of dropped events (in reward)
+  std::int32_t arm;
+  double reward;
+  double fitness;
+};
+
+/**
+ * Binary trace of operator selection events. record() only stores the event
+ * in a fixed size ring buffer (lock-free, callable from several threads) and
+ * never blocks: events are dropped when the buffer is full. A background
+ * thread drains the buffer into the file.
+ *
+ * File format: "AOST", a uint32 version, then 28 byte records with the
+ * fields of AOSTraceEvent in native byte order. If events were dropped, the
+ * last record has arm -1 and their number as reward.
+ */
+class AOSTraceWriter {
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    AOSTraceEvent event;
+  };
+
+  const std::size_t mask;
+  std::unique_ptr<Cell[]> cells;
+  alignas(64) std::atomic<std::size_t> enqueuePos{0};
+  alignas(64) std::size_t dequeuePos = 0;
+  std::atomic<long> dropped{0};
+  std::atomic<double> currentFitness{0.0};
+  const std::chrono::steady_clock::time_point start;
+
+  std::ofstream out;
+  std::string buffer;
+  std::mutex mutex;
+  std::condition_variable wake;
+  bool stopping = false;
+  std::thread flusher;
+
+  void append(const AOSTraceEvent& event) {
+    char record[recordSize];
+    std::memcpy(record, &event.time, 8);
+    std::memcpy(record + 8, &event.arm, 4);
+    std::memcpy(record + 12, &event.reward, 8);
+    std::memcpy(record + 20, &event.fitness, 8);
+    buffer.append(record, recordSize);
+  }
+
+  /** Moves the available events to the file, only called by one thread. */
+  void drain() {
+    buffer.clear();
+    while (true) {
+      Cell& cell = cells[dequeuePos & mask];
+      if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+        break;
+      append(cell.event);
+      cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+      dequeuePos++;
+    }
+    out.write(buffer.data(), buffer.size());
+  }
+
+  void flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+      wake.wait_for(lock, std::chrono::milliseconds(50));
+      drain();
+    }
+  }
+
+ public:
+  static constexpr char magic[4] = {'A', 'O', 'S', 'T'};
+  static constexpr std::uint32_t version = 1;
+  static constexpr int recordSize = 28;
+
+  /** The buffer holds the next power of two of capacity events. */
+  explicit AOSTraceWriter(const std::string& filename,
+                          std::size_t capacity = 1 << 16)
+      : mask{[capacity]() {
+          std::size_t size = 2;
+          while (size < capacity)
+            size *= 2;
+          return size - 1;
+        }()},
+        cells{new Cell[mask + 1]},
+        start{std::chrono::steady_clock::now()},
+        out(filename, std::ios::binary) {
+    if (!out)
+      throw std::runtime_error("Could not open " + filename);
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    for (std::size_t i = 0; i <= mask; i++)
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    flusher = std::thread([this]() { flushLoop(); });
+  }
+
+  AOSTraceWriter(const AOSTraceWriter&) = delete;
+  auto operator=(const AOSTraceWriter&) -> AOSTraceWriter& = delete;
+
+  ~AOSTraceWriter() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_one();
+    flusher.join();
+    drain();
+    if (dropped > 0) {
+      buffer.clear();
+      append({elapsed(), -1, static_cast<double>(dropped.load()), 0.0});
+      out.write(buffer.data(), buffer.size());
+    }
+  }
+
+  [[nodiscard]] auto elapsed() const -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  /** Fitness stored with the next events. */
+  void fitness(double value) {
+    currentFitness.store(value, std::memory_order_relaxed);
+  }
+
+  void record(int arm, double reward) {
+    record(arm, reward, currentFitness.load(std::memory_order_relaxed));
+  }
+
+  void record(int arm, double reward, double fitness) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells[pos & mask];
+      const std::size_t sequence =
+          cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                        static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->event = {elapsed(), arm, reward, fitness};
+    cell->sequence.store(pos + 1, std::memory_order_release);
+  }
+};
+
+/** Keeps the fitness of the trace up to date from a checkpoint. */
+template <class EOT>
+class AOSTraceFitness : public moStatBase<EOT> {
+  AOSTraceWriter& trace;
+
+ public:
+  explicit AOSTraceFitness(AOSTraceWriter& trace) : trace{trace} {}
+
+  void operator()(EOT& sol) final { trace.fitness(sol.fitness()); }
+};
+
+/** Calls onEvent for every event of a file written by AOSTraceWriter. */
+template <class OnEvent>
+void readAOSTrace(const std::string& filename, OnEvent onEvent) {
+  std::ifstream in(filename, std::ios::binary);
+  char header[4];
+  std::uint32_t version = 0;
+  if (!in.read(header, sizeof(header)) ||
+      !std::equal(header, header + 4, AOSTraceWriter::magic) ||
+      !in.read(reinterpret_cast<char*>(&version), sizeof(version)) ||
+      version != AOSTraceWriter::version)
+    throw std::runtime_error("Not an AOS trace file: " + filename);
+  char record[AOSTraceWriter::recordSize];
+  while (in.read(record, sizeof(record))) {
+    AOSTraceEvent event;
+    std::memcpy(&event.time, record, 8);
+    std::memcpy(&event.arm, record + 8, 4);
+    std::memcpy(&event.reward, record + 12, 8);
+    std::memcpy(&event.fitness, record + 20, 8);
+    onEvent(event);
+  }
+  if (in.gcount() != 0)
+    throw std::runtime_error("Truncated AOS trace file: " + filename);
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
 #include <vector>
 
 #include "flowshop-solver/aos/adaptive_operator_selection.hpp"
@@ -101,6 +104,11 @@ struct SlidingWindow {
 
   void clear(T el) { std::fill(data.begin(), data.end(), el); }
 
+  /** Element appended `age` appends before the newest one, for age < size. */
+  [[nodiscard]] auto fromNewest(size_type age) const -> const T& {
+    return data[(curr_begin + data.size() - 1 - age) % data.size()];
+  }
+
   auto operator<<(T& el) -> SlidingWindow& {
     append(el);
     return *this;
@@ -131,6 +139,15 @@ auto makeIndexed(const T& val, int idx = 0) -> Indexed<T> {
   return Indexed<T>(val, idx);
 }
 
+/**
+ * Fitness-Rate-Rank based multi-armed bandit. The rewards and counts of the
+ * operators in the window are running sums, updated as records enter and
+ * leave it, and the active operators (those in the window) are kept sorted
+ * by reward, moved by insertion when their sums change. Rank decays are only
+ * recomputed when this order changes, so an update costs O(A) for A active
+ * operators whatever the window size. The sums are recounted from the window
+ * once per window size updates, so rounding errors do not accumulate.
+ */
 template <typename OpT>
 class FRRMAB : public OperatorSelection<OpT> {
  protected:
@@ -138,29 +155,59 @@ class FRRMAB : public OperatorSelection<OpT> {
     int idx = -1;
 
     if (unused_operators_exist) {
-      idx               = RNG::intUniform(0, noOperators() - 1);
-      not_selected[idx] = false;
-      unused_operators_exist =
-          std::any_of(not_selected.begin(), not_selected.end(),
-                      [](const bool b) { return b; });
-    } else {
-      double       max_opt = -std::numeric_limits<double>::infinity();
-      const double log_sum = 2.0 * log(sum(num.data(), num.size()));
-      for (int i = 0; i < noOperators(); ++i) {
-        if (num[i] > 0) {
-          const double opt = frr[i] + scale * sqrt(log_sum / num[i]);
-          if (opt > max_opt) {
-            max_opt = opt;
-            idx     = i;
-          }
-        }
+      idx = RNG::intUniform(0, noOperators() - 1);
+      if (not_selected[idx]) {
+        not_selected[idx] = false;
+        no_not_selected--;
       }
-      assert(idx != -1);
+      unused_operators_exist = no_not_selected > 0;
+    } else {
+      assert(best >= 0);
+      idx = best;
     }
     last_op = idx;
     return idx;
   }
 
+  /** Rewards of other workers enter the window as one record. */
+  void observe(int op, const SharedOperatorRewards::Totals& delta) final {
+    slide(Indexed<double>(delta.sum, op));
+  }
+
+  /** Window records from the oldest, then which operators were never used. */
+  void writeState(std::ostream& os) const final {
+    const auto size = fir_records.size();
+    os << ' ' << size;
+    for (std::size_t age = size; age-- > 0;) {
+      const auto& record = fir_records.fromNewest(age);
+      os << ' ' << record.idx << ' ' << record.val;
+    }
+    this->writeValues(os, int_vec(not_selected.begin(), not_selected.end()));
+  }
+
+  auto readState(std::istream& is) -> bool final {
+    long size = 0;
+    if (!(is >> size))
+      throw std::runtime_error("Invalid AOS state");
+    const auto records = this->template readValues<double>(is, 2 * size);
+    const auto unused = this->template readValues<int>(is, noOperators());
+    for (long j = 0; j < size; j++)
+      if (records[2 * j] < -1 || records[2 * j] >= noOperators())
+        throw std::runtime_error("Invalid AOS state");
+    reset(0.0);
+    // a smaller window keeps the newest records
+    for (long j = 0; j < size; j++)
+      slide(Indexed<double>(records[2 * j + 1],
+                            static_cast<int>(records[2 * j])));
+    rank();
+    for (int i = 0; i < noOperators(); i++) {
+      not_selected[i] = unused[i] != 0 || best < 0;
+      no_not_selected -= !not_selected[i];
+    }
+    unused_operators_exist = no_not_selected > 0;
+    return true;
+  }
+
  public:
   using OperatorSelection<OpT>::doAdapt;
   using OperatorSelection<OpT>::noOperators;
@@ -178,61 +225,45 @@ class FRRMAB : public OperatorSelection<OpT> {
         scale(scale),
         decay(decay),
         last_op(-1),
-        fir_records(window_size, Indexed<double>(-1, 0.0)),
-        fir(noOperators()),
+        fir_records(window_size, Indexed<double>(0.0, -1)),
         frr(noOperators()),
         reward(noOperators()),
         num(noOperators()),
-        ranks(noOperators()),
+        position(noOperators(), -1),
+        weights(noOperators()),
+        decayPowers(noOperators() + 1, 1.0),
         not_selected(noOperators()),
         unused_operators_exist(true) {
+    for (int r = 1; r <= noOperators(); r++)
+      decayPowers[r] = decayPowers[r - 1] * decay;
     reset(0.0);
   };
 
   void reset(double) final {
     last_op = -1;
-    fir_records.clear(Indexed<double>(-1, 0.0));
+    fir_records.clear(Indexed<double>(0.0, -1));
     using std::fill;
     fir = 0;
     fill(frr.begin(), frr.end(), 0.0);
     fill(reward.begin(), reward.end(), 0.0);
     fill(num.begin(), num.end(), 0);
+    fill(position.begin(), position.end(), -1);
     fill(not_selected.begin(), not_selected.end(), true);
+    no_not_selected = noOperators();
     unused_operators_exist = true;
+    order.clear();
+    orderChanged = true;
+    total = 0;
+    slides = 0;
+    best = -1;
     OperatorSelection<OpT>::reset(0);
   };
 
   void update() final {
-    std::fill(reward.begin(), reward.end(), 0.0);
-    std::fill(num.begin(), num.end(), 0);
-
-    fir_records.append(Indexed<double>(fir, last_op));
-    for (const auto& el : fir_records) {
-      if (el.idx >= 0) {
-        reward[el.idx] += el.val;
-        num[el.idx]++;
-      }
-    }
-
-    std::iota(ranks.begin(), ranks.end(), 0);
-    std::sort(ranks.begin(), ranks.end(), [this](const int& a, const int& b) {
-      return this->reward[a] > this->reward[b];
-    });
-    for (auto& r : ranks)
-      r++;
-
-    last_op    = -1;
-    double sum = 0.0;
-    for (int i = 0; i < noOperators(); ++i) {
-      frr[i] = intpow(decay, ranks[i]) * reward[i];
-      sum += frr[i];
-    }
-    if (sum > 0.0) {
-      for (int i = 0; i < noOperators(); ++i)
-        frr[i] = frr[i] / sum;
-    }
-
+    slide(Indexed<double>(fir, last_op));
+    last_op = -1;
     fir = 0;
+    rank();
   }
 
   void doFeedback(double feedback) final { fir += feedback; }
@@ -246,16 +277,153 @@ class FRRMAB : public OperatorSelection<OpT> {
   }
 
  private:
-  auto intpow(double base, int exp) -> double {
-    double result = 1.0;
-    while (exp != 0) {
-      if ((exp & 1) == 1)
-        result *= base;
-      exp >>= 1;
-      base *= base;
+  /** Appends a record to the window, moving the sums of the oldest one out. */
+  void slide(const Indexed<double>& record) {
+    const Indexed<double> oldest =
+        fir_records.fromNewest(fir_records.size() - 1);
+    fir_records.append(record);
+    if (++slides == static_cast<long>(fir_records.size())) {
+      slides = 0;
+      recount();
+      return;
     }
+    if (oldest.idx >= 0)
+      leave(oldest);
+    if (record.idx >= 0)
+      enter(record);
+  }
 
-    return result;
+  void enter(const Indexed<double>& record) {
+    const int i = record.idx;
+    const bool wasNegative = reward[i] < 0.0;
+    reward[i] += record.val;
+    total++;
+    if (num[i]++ == 0) {
+      position[i] = order.size();
+      order.push_back(i);
+      moveUp(i);
+      orderChanged = true;
+    } else {
+      reposition(i, wasNegative);
+    }
+  }
+
+  void leave(const Indexed<double>& record) {
+    const int i = record.idx;
+    const bool wasNegative = reward[i] < 0.0;
+    reward[i] -= record.val;
+    total--;
+    if (--num[i] > 0) {
+      reposition(i, wasNegative);
+      return;
+    }
+    reward[i] = 0.0;
+    order.erase(order.begin() + position[i]);
+    for (int at = position[i]; at < static_cast<int>(order.size()); at++)
+      position[order[at]] = at;
+    position[i] = -1;
+    orderChanged = true;
+  }
+
+  /** Sums and order computed from the whole window. */
+  void recount() {
+    for (int i : order) {
+      reward[i] = 0.0;
+      num[i] = 0;
+      position[i] = -1;
+    }
+    order.clear();
+    total = 0;
+    for (std::size_t age = 0; age < fir_records.size(); age++) {
+      const auto& record = fir_records.fromNewest(age);
+      if (record.idx < 0)
+        continue;
+      if (num[record.idx]++ == 0)
+        order.push_back(record.idx);
+      reward[record.idx] += record.val;
+      total++;
+    }
+    std::sort(order.begin(), order.end(),
+              [this](int a, int b) { return before(a, b); });
+    for (int at = 0; at < static_cast<int>(order.size()); at++)
+      position[order[at]] = at;
+    orderChanged = true;
+  }
+
+  /** Order of the active operators: decreasing reward, then index. */
+  [[nodiscard]] auto before(int a, int b) const -> bool {
+    return reward[a] > reward[b] || (reward[a] == reward[b] && a < b);
+  }
+
+  void reposition(int i, bool wasNegative) {
+    const bool movedUp = moveUp(i);
+    const bool movedDown = moveDown(i);
+    if (movedUp || movedDown || wasNegative != (reward[i] < 0.0))
+      orderChanged = true;
+  }
+
+  auto moveUp(int i) -> bool {
+    int at = position[i];
+    const int from = at;
+    for (; at > 0 && before(i, order[at - 1]); at--) {
+      order[at] = order[at - 1];
+      position[order[at]] = at;
+    }
+    order[at] = i;
+    position[i] = at;
+    return at != from;
+  }
+
+  auto moveDown(int i) -> bool {
+    int at = position[i];
+    const int from = at;
+    const int last = static_cast<int>(order.size()) - 1;
+    for (; at < last && before(order[at + 1], i); at++) {
+      order[at] = order[at + 1];
+      position[order[at]] = at;
+    }
+    order[at] = i;
+    position[i] = at;
+    return at != from;
+  }
+
+  /**
+   * Credits of the active operators and the one with the largest UCB value
+   * (the smallest index among ties). All UCB values change with the total
+   * count, so they are scanned on every update.
+   */
+  void rank() {
+    const int noActive = static_cast<int>(order.size());
+    if (orderChanged) {
+      // inactive operators have reward 0, ranked above the negative ones
+      const int noInactive = noOperators() - noActive;
+      for (int r = 0; r < noActive; r++) {
+        const int i = order[r];
+        weights[i] = decayPowers[r + 1 + (reward[i] < 0.0 ? noInactive : 0)];
+      }
+      orderChanged = false;
+    }
+
+    double sum = 0.0;
+    for (int i : order) {
+      frr[i] = weights[i] * reward[i];
+      sum += frr[i];
+    }
+    if (sum > 0.0) {
+      for (int i : order)
+        frr[i] = frr[i] / sum;
+    }
+
+    const double log_sum = 2.0 * log(total);
+    best = -1;
+    double bestUcb = 0.0;
+    for (int i : order) {
+      const double ucb = frr[i] + scale * sqrt(log_sum / num[i]);
+      if (best < 0 || ucb > bestUcb || (ucb == bestUcb && i < best)) {
+        best = i;
+        bestUcb = ucb;
+      }
+    }
   }
 
   const double scale;
@@ -270,12 +438,25 @@ class FRRMAB : public OperatorSelection<OpT> {
 
   double   fir;
   real_vec frr;
+  // window sums of the rewards and number of records of each operator
   real_vec reward;
   int_vec  num;
-  int_vec  ranks;
+  int      total = 0;
+  long     slides = 0;
+
+  // active operators by decreasing reward, and their position in it
+  int_vec  order;
+  int_vec  position;
+  bool     orderChanged = true;
+  real_vec weights;
+  real_vec decayPowers;
 
   bool_vec not_selected;
+  int      no_not_selected = 0;
   bool     unused_operators_exist;
+
+  // active operator with the largest UCB value, -1 when there is none
+  int best = -1;
 };
 
 template <typename OpT>
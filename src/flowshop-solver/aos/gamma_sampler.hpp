@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+/**
+ * Gamma(shape, 1) sampler of Marsaglia and Tsang (2000). The constants
+ * d = a - 1/3 and c = 1 / sqrt(9 d) only depend on the shape, so they are
+ * computed once in set() instead of on every draw. Shapes below 1 are
+ * sampled as Gamma(a + 1) U^(1/a), and shape 0 always gives 0.
+ */
+class GammaSampler {
+  double shape = 0.0;
+  double d = 0.0;
+  double c = 0.0;
+  double invShape = 0.0;
+  bool boost = false;
+
+  static auto unit(std::mt19937_64& engine) -> double {
+    return static_cast<double>(engine() >> 11) * 0x1.0p-53;
+  }
+
+ public:
+  explicit GammaSampler(double shape = 1.0) { set(shape); }
+
+  void set(double a) {
+    shape = a;
+    boost = a < 1.0;
+    invShape = a > 0.0 ? 1.0 / a : 0.0;
+    d = (boost ? a + 1.0 : a) - 1.0 / 3.0;
+    c = 1.0 / std::sqrt(9.0 * d);
+  }
+
+  [[nodiscard]] auto a() const -> double { return shape; }
+
+  auto operator()(std::mt19937_64& engine,
+                  std::normal_distribution<double>& normal) const -> double {
+    if (shape <= 0.0)
+      return 0.0;
+    double x, v;
+    while (true) {
+      do {
+        x = normal(engine);
+        v = 1.0 + c * x;
+      } while (v <= 0.0);
+      v = v * v * v;
+      const double u = unit(engine);
+      const double x2 = x * x;
+      if (u < 1.0 - 0.0331 * x2 * x2 ||
+          std::log(u) < 0.5 * x2 + d * (1.0 - v + std::log(v)))
+        break;
+    }
+    const double sample = d * v;
+    return boost ? sample * std::pow(unit(engine), invShape) : sample;
+  }
+};
@@ -30,17 +30,39 @@ class ProblemContext : public eoFunctorBase {
 using Eigen::MatrixXd;
 using Eigen::VectorXd;
 
+/**
+ * LinUCB with disjoint linear models. The inverse of A_k = I + sum x x^T is
+ * kept with Sherman-Morrison updates, O(d^2) per feedback. The context is
+ * computed once per update() and the scores of all operators,
+ * theta_k^T x + alpha sqrt(x^T A_k^-1 x), are computed with one
+ * matrix-vector product.
+ */
 template <class OpT>
 class LinUCB : public OperatorSelection<OpT> {
   const double          alpha;
   ProblemContext&       context;
-  std::vector<MatrixXd> A;
+  std::vector<MatrixXd> Ainv;
   std::vector<VectorXd> b;
-  std::vector<VectorXd> theta;
+  MatrixXd              theta;
   VectorXd              x;
+  // x^T A_k^-1 x for the current context
+  VectorXd              width;
   VectorXd              p;
+  bool                  hasContext = false;
   int                   opIdx = -1;
 
+  void updateContext() {
+    std::vector<double> features = context.compute();
+    const VectorXd      current =
+        Eigen::Map<VectorXd>(features.data(), features.size());
+    if (hasContext && current == x)
+      return;
+    x = current;
+    for (int k = 0; k < static_cast<int>(Ainv.size()); k++)
+      width(k) = x.dot(Ainv[k] * x);
+    hasContext = true;
+  }
+
   protected:
 
   auto selectOperatorIdx() -> int override {
@@ -48,6 +70,37 @@ class LinUCB : public OperatorSelection<OpT> {
     return opIdx;
   }
 
+  /** Context size, then A_k^-1 and b_k of every operator. */
+  void writeState(std::ostream& os) const override {
+    os << ' ' << context.size();
+    for (std::size_t k = 0; k < Ainv.size(); k++) {
+      for (Eigen::Index i = 0; i < Ainv[k].size(); i++)
+        os << ' ' << Ainv[k](i);
+      for (Eigen::Index i = 0; i < b[k].size(); i++)
+        os << ' ' << b[k](i);
+    }
+  }
+
+  auto readState(std::istream& is) -> bool override {
+    int d = 0;
+    if (!(is >> d))
+      throw std::runtime_error("Invalid AOS state");
+    if (d != context.size())
+      return false;
+    const auto values =
+        this->template readValues<double>(is, Ainv.size() * (d * d + d));
+    auto value = values.begin();
+    for (std::size_t k = 0; k < Ainv.size(); k++) {
+      for (Eigen::Index i = 0; i < Ainv[k].size(); i++)
+        Ainv[k](i) = *value++;
+      for (Eigen::Index i = 0; i < b[k].size(); i++)
+        b[k](i) = *value++;
+      theta.row(k) = (Ainv[k] * b[k]).transpose();
+    }
+    hasContext = false;
+    return true;
+  }
+
  public:
   LinUCB(std::vector<OpT>             operators,
          ProblemContext&              context,
@@ -55,28 +108,35 @@ class LinUCB : public OperatorSelection<OpT> {
       : OperatorSelection<OpT>{operators},
         alpha{alpha},
         context{context},
-        A{operators.size(), MatrixXd::Identity(context.size(), context.size())},
+        Ainv{operators.size(),
+             MatrixXd::Identity(context.size(), context.size())},
         b{operators.size(), VectorXd::Zero(context.size())},
-        theta{operators.size(), VectorXd{context.size()}},
-        x{context.size()},
+        theta{MatrixXd::Zero(operators.size(), context.size())},
+        x{VectorXd::Zero(context.size())},
+        width{VectorXd::Zero(operators.size())},
         p{VectorXd::Constant(operators.size(), 0.5)} {
     assert(alpha >= 0);
   }
 
-  void update() final{};
+  void update() final {
+    updateContext();
+    p = theta * x + alpha * width.cwiseSqrt();
+  };
 
   void doFeedback(double reward) final {
     if (opIdx == -1)
       return;
-    std::vector<double> features = context.compute();
-    x = Eigen::Map<VectorXd>(features.data(), features.size());
+    if (!hasContext)
+      updateContext();
 
-    A[opIdx]     = A[opIdx] + x * x.transpose();
-    b[opIdx]     = b[opIdx] + reward * x;
-    theta[opIdx] = A[opIdx].colPivHouseholderQr().solve(b[opIdx]);
+    const VectorXd Ax = Ainv[opIdx] * x;
+    const double   s  = x.dot(Ax);
+    Ainv[opIdx].noalias() -= (Ax * Ax.transpose()) / (1.0 + s);
+    b[opIdx] += reward * x;
+    theta.row(opIdx) = (Ainv[opIdx] * b[opIdx]).transpose();
 
-    double prod = x.transpose() * A[opIdx] * x;
-    p(opIdx)    = theta[opIdx].transpose() * x + alpha * std::sqrt(prod);
+    width(opIdx) = s / (1.0 + s);
+    p(opIdx)     = theta.row(opIdx).dot(x) + alpha * std::sqrt(width(opIdx));
   }
 
   auto printOn(std::ostream& os) -> std::ostream& final {
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+
+#include <paradiseo/eo/eoFunctor.h>
+
+/**
+ * Monotonic measure of the effort spent by a search. An operator selection
+ * charged with it divides each reward by the effort spent between the
+ * selection and the feedback, rewarding improvement per unit of effort.
+ */
+class OperatorCost : public eoFunctorBase {
+ public:
+  virtual auto now() -> double = 0;
+
+  /** Smallest effort charged, so that instant operators are not divided by 0. */
+  [[nodiscard]] virtual auto resolution() const -> double = 0;
+};
+
+/** Wall-clock milliseconds from a steady clock. */
+class TimeCost : public OperatorCost {
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+
+ public:
+  auto now() -> double override {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+  }
+
+  [[nodiscard]] auto resolution() const -> double override { return 1e-3; }
+};
+
+/** Solution and neighbor evaluations counted by the problem. */
+template <class ProblemT>
+class EvaluationCost : public OperatorCost {
+  ProblemT& problem;
+
+ public:
+  explicit EvaluationCost(ProblemT& problem) : problem{problem} {}
+
+  auto now() -> double override {
+    return static_cast<double>(problem.evalCount());
+  }
+
+  [[nodiscard]] auto resolution() const -> double override { return 1.0; }
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <limits>
@@ -7,8 +8,20 @@
 #include <cassert>
 
 #include "flowshop-solver/aos/adaptive_operator_selection.hpp"
+#include "flowshop-solver/aos/sum_tree.hpp"
 #include "flowshop-solver/global.hpp"
 
+/**
+ * Probability matching. The probability of operator k is
+ * p_min + (1 - K p_min) q_k / sum(q), so an operator is drawn uniformly with
+ * probability K p_min and proportionally to its quality otherwise, from a
+ * SumTree in O(log K).
+ *
+ * Qualities are stored as q_k = scale * scaled_k: decaying every quality by
+ * (1 - alpha) only changes the scale, and an update only touches the
+ * operators that received feedback in the window. Negative qualities get no
+ * proportional share.
+ */
 template <typename OpT>
 class ProbabilityMatching : public OperatorSelection<OpT> {
  public:
@@ -23,18 +36,30 @@ class ProbabilityMatching : public OperatorSelection<OpT> {
   double best_fitness;
   int chosen_strat;
 
-  real_vec quality;
+  real_vec scaled;
+  double scale = 1.0;
+  double scaledSum = 0.0;
   real_vec reward;
-  real_vec prob;
   real_vec S;
   int_vec nr_S;
   real_vec maior_S;
+  // operators with feedback since the last update
+  int_vec touched;
+  std::vector<char> isTouched;
+
+  // proportional part of the probabilities, kept while the total quality is
+  // too small to update them
+  SumTree proportional;
+  bool uniform = true;
+  int_vec pending;
+  bool rebuildProportional = false;
 
   int updateCounter = 0;
   int updateWindow = 5;
 
   void updateRewards();
   auto updateQualities() -> double;
+  void rescale();
 
   auto rewardTypeFromString(std::string str) -> RewardType {
     for (auto& c : str)
@@ -54,16 +79,50 @@ class ProbabilityMatching : public OperatorSelection<OpT> {
  protected:
   auto selectOperatorIdx() -> int {
     const auto rnd = RNG::realUniform<double>();
-    double aux = 0.0;
-    for (int k = 0; k < noOperators(); k++) {
-      aux += prob[k];
-      if (rnd <= aux) {
-        chosen_strat = k;
-        return k;
-      }
+    const double uniformShare = std::min(1.0, noOperators() * p_min);
+    if (uniform || rnd < uniformShare) {
+      const double width = uniform ? 1.0 : uniformShare;
+      chosen_strat = std::min(static_cast<int>(rnd / width * noOperators()),
+                              noOperators() - 1);
+    } else {
+      const double u = (rnd - uniformShare) / (1.0 - uniformShare);
+      chosen_strat = proportional.find(u * proportional.total());
     }
-    assert(false);
-    return 0;
+    return chosen_strat;
+  }
+
+  void touch(int k) {
+    if (!isTouched[k]) {
+      isTouched[k] = 1;
+      touched.push_back(k);
+    }
+  }
+
+  void observe(int op, const SharedOperatorRewards::Totals& delta) final;
+
+  /** Qualities, without the rewards of the current window. */
+  void writeState(std::ostream& os) const final {
+    real_vec qualities(noOperators());
+    for (int k = 0; k < noOperators(); ++k)
+      qualities[k] = scale * scaled[k];
+    os << ' ' << uniform;
+    this->writeValues(os, qualities);
+  }
+
+  auto readState(std::istream& is) -> bool final {
+    bool wasUniform = true;
+    is >> wasUniform;
+    const auto qualities = this->template readValues<double>(is, noOperators());
+    reset(best_fitness);
+    real_vec weights(noOperators());
+    for (int k = 0; k < noOperators(); ++k) {
+      scaled[k] = qualities[k];
+      scaledSum += qualities[k];
+      weights[k] = std::max(qualities[k], 0.0);
+    }
+    proportional.assign(weights);
+    uniform = wasUniform;
+    return true;
   }
 
  public:
@@ -79,12 +138,13 @@ class ProbabilityMatching : public OperatorSelection<OpT> {
         alpha(alpha),
         p_min(p_min),
         rew_type(rew_type),
-        quality(operators.size()),
+        scaled(operators.size()),
         reward(operators.size()),
-        prob(operators.size()),
         S(operators.size()),
         nr_S(operators.size()),
         maior_S(operators.size()),
+        isTouched(operators.size()),
+        proportional(operators.size()),
         updateCounter{1},
         updateWindow{updateWindow} {
     reset(std::numeric_limits<double>::infinity());
@@ -135,11 +195,18 @@ void ProbabilityMatching<OpT>::reset(double best_f) {
   best_fitness = best_f;
   chosen_strat = -1;
   using std::fill;
-  fill(quality.begin(), quality.end(), 0.0);
-  fill(prob.begin(), prob.end(), 1.0 / noOperators());
+  fill(scaled.begin(), scaled.end(), 0.0);
+  scale = 1.0;
+  scaledSum = 0.0;
   fill(S.begin(), S.end(), 0.0);
   fill(nr_S.begin(), nr_S.end(), 0);
   fill(maior_S.begin(), maior_S.end(), 0.0);
+  fill(isTouched.begin(), isTouched.end(), 0);
+  touched.clear();
+  proportional.assign(real_vec(noOperators(), 0.0));
+  uniform = true;
+  pending.clear();
+  rebuildProportional = false;
 }
 
 template <typename OpT>
@@ -150,8 +217,23 @@ void ProbabilityMatching<OpT>::doFeedback(double feedback) {
   nr_S[chosen_strat]++;
   if (feedback > maior_S[chosen_strat])
     maior_S[chosen_strat] = feedback;
+  touch(chosen_strat);
 };
 
+/**
+ * Rewards of other workers count in the window like local ones. Only their
+ * sum is shared, so their mean stands for their maximum in extreme rewards.
+ */
+template <typename OpT>
+void ProbabilityMatching<OpT>::observe(
+    int op,
+    const SharedOperatorRewards::Totals& delta) {
+  S[op] += delta.sum;
+  nr_S[op] += delta.count;
+  maior_S[op] = std::max(maior_S[op], delta.sum / delta.count);
+  touch(op);
+}
+
 template <typename OpT>
 void ProbabilityMatching<OpT>::update() {
   updateCounter++;
@@ -163,68 +245,93 @@ void ProbabilityMatching<OpT>::update() {
   if (q_total <= 1e-6)  // no improvement, maintain the probabilities
     return;
 
-  const double s = (1.0 - noOperators() * p_min) / q_total;
-  for (int k = 0; k < noOperators(); ++k)
-    prob[k] = p_min + s * quality[k];
+  if (rebuildProportional) {
+    real_vec weights(noOperators());
+    for (int k = 0; k < noOperators(); ++k)
+      weights[k] = std::max(scaled[k], 0.0);
+    proportional.assign(weights);
+    rebuildProportional = false;
+  } else {
+    for (int k : pending)
+      proportional.set(k, std::max(scaled[k], 0.0));
+  }
+  pending.clear();
+  uniform = false;
 
-  using std::fill;
-  fill(S.begin(), S.end(), 0.0);
-  fill(nr_S.begin(), nr_S.end(), 0);
-  fill(maior_S.begin(), maior_S.end(), 0.0);
+  for (int k : touched) {
+    S[k] = 0.0;
+    nr_S[k] = 0;
+    maior_S[k] = 0.0;
+    isTouched[k] = 0;
+  }
+  touched.clear();
 }
 
 template <typename OpT>
 void ProbabilityMatching<OpT>::updateRewards() {
   switch (rew_type) {
     case RewardType::AvgAbs: {
-      for (int k = 0; k < noOperators(); ++k)
+      for (int k : touched)
         reward[k] = nr_S[k] > 0 ? S[k] / nr_S[k] : 0.0;
       break;
     }
     case RewardType::AvgNorm: {
-      std::vector<double> rew_linha(noOperators());
       double max_rew_linha = 0.0;
-      // calcula o r_linha
-      for (int k = 0; k < noOperators(); ++k) {
-        rew_linha[k] = nr_S[k] > 0 ? S[k] / nr_S[k] : 0.0;
-        // acha o maior r_linha
-        if (rew_linha[k] > max_rew_linha)
-          max_rew_linha = rew_linha[k];
+      for (int k : touched) {
+        reward[k] = nr_S[k] > 0 ? S[k] / nr_S[k] : 0.0;
+        if (reward[k] > max_rew_linha)
+          max_rew_linha = reward[k];
       }
-      // calcula o reward
-      for (int k = 0; k < noOperators(); ++k)
-        reward[k] = nr_S[k] > 0 ? rew_linha[k] / (max_rew_linha + 1e-6) : 0.0;
+      for (int k : touched)
+        reward[k] = nr_S[k] > 0 ? reward[k] / (max_rew_linha + 1e-6) : 0.0;
       break;
     }
     case RewardType::ExtAbs: {
-      for (int k = 0; k < noOperators(); ++k)
+      for (int k : touched)
         reward[k] = maior_S[k];
       break;
     }
     case RewardType::ExtNorm: {
-      std::vector<double> rew_linha(noOperators());
       double max_rew_linha = 0.000001;
-      // calcula r_linha
-      for (int k = 0; k < noOperators(); k++) {
-        rew_linha[k] = maior_S[k];
-        // acha o maior r_linha
-        if (rew_linha[k] > max_rew_linha)
-          max_rew_linha = rew_linha[k];
-      }
-      // calcula o reward
-      for (int k = 0; k < noOperators(); k++)
-        reward[k] = rew_linha[k] / max_rew_linha;  // WO: division by 0!
+      for (int k : touched)
+        if (maior_S[k] > max_rew_linha)
+          max_rew_linha = maior_S[k];
+      for (int k : touched)
+        reward[k] = maior_S[k] / max_rew_linha;
       break;
     }
   }
 }
 
+/**
+ * q_k <- q_k + alpha (r_k - q_k) for all k, where only touched operators have
+ * a reward: the scale decays and their scaled qualities grow by
+ * alpha r_k / scale.
+ */
 template <typename OpT>
 auto ProbabilityMatching<OpT>::updateQualities() -> double {
-  double q_total = 0.0;
+  scale *= 1.0 - alpha;
+  if (scale < 1e-30)
+    rescale();
+  for (int k : touched) {
+    if (reward[k] == 0.0)
+      continue;
+    const double delta = alpha * reward[k] / scale;
+    scaled[k] += delta;
+    scaledSum += delta;
+    pending.push_back(k);
+  }
+  return scale * scaledSum;
+}
+
+/** Moves the scale into the scaled qualities before it underflows. */
+template <typename OpT>
+void ProbabilityMatching<OpT>::rescale() {
+  scaledSum = 0.0;
   for (int k = 0; k < noOperators(); ++k) {
-    quality[k] = quality[k] + alpha * (reward[k] - quality[k]);
-    q_total = q_total + quality[k];
+    scaled[k] *= scale;
+    scaledSum += scaled[k];
   }
-  return q_total;
+  scale = 1.0;
+  rebuildProportional = true;
 }
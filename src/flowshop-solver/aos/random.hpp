@@ -11,7 +11,7 @@ class Random : public OperatorSelection<OpT> {
   std::uniform_int_distribution<int> dist;
 
  protected:
-  auto selectOperatorIdx() -> int override { return dist(RNG::engine); }
+  auto selectOperatorIdx() -> int override { return dist(RNG::localEngine()); }
 
  public:
   Random(const std::vector<OpT>& strategies)
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Operator rewards of an AOS shared by concurrent workers. Each worker owns
+ * one slot per operator and is its only writer, so pushing a reward never
+ * waits. A sequence counter per slot lets the other workers read consistent
+ * totals without locks, retrying only if they raced with a push.
+ */
+class SharedOperatorRewards {
+ public:
+  struct Totals {
+    double sum = 0.0;
+    long count = 0;
+    // rewards greater than zero
+    long positives = 0;
+  };
+
+ private:
+  struct alignas(64) Slot {
+    std::atomic<unsigned> sequence{0};
+    std::atomic<double> sum{0.0};
+    std::atomic<long> count{0};
+    std::atomic<long> positives{0};
+  };
+
+  const int noOperators_;
+  const int maxWorkers_;
+  std::unique_ptr<Slot[]> slots;
+  std::atomic<int> noWorkers{0};
+
+  auto slot(int worker, int op) const -> Slot& {
+    return slots[worker * noOperators_ + op];
+  }
+
+ public:
+  SharedOperatorRewards(int noOperators, int maxWorkers)
+      : noOperators_{noOperators},
+        maxWorkers_{maxWorkers},
+        slots{new Slot[noOperators * maxWorkers]} {}
+
+  [[nodiscard]] auto noOperators() const -> int { return noOperators_; }
+  [[nodiscard]] auto maxWorkers() const -> int { return maxWorkers_; }
+
+  /** Id of a new worker. */
+  auto addWorker() -> int {
+    const int worker = noWorkers.fetch_add(1);
+    if (worker >= maxWorkers_)
+      throw std::runtime_error("Too many workers sharing operator rewards");
+    return worker;
+  }
+
+  /** Adds a reward of the operator, only called by the worker. */
+  void push(int worker, int op, double reward) {
+    Slot& s = slot(worker, op);
+    const unsigned sequence = s.sequence.load(std::memory_order_relaxed);
+    s.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.sum.store(s.sum.load(std::memory_order_relaxed) + reward,
+                std::memory_order_relaxed);
+    s.count.store(s.count.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+    if (reward > 0.0)
+      s.positives.store(s.positives.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+    s.sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  /** Totals pushed by the worker for the operator, from any thread. */
+  [[nodiscard]] auto read(int worker, int op) const -> Totals {
+    const Slot& s = slot(worker, op);
+    while (true) {
+      const unsigned before = s.sequence.load(std::memory_order_acquire);
+      Totals totals;
+      totals.sum = s.sum.load(std::memory_order_relaxed);
+      totals.count = s.count.load(std::memory_order_relaxed);
+      totals.positives = s.positives.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (before % 2 == 0 &&
+          s.sequence.load(std::memory_order_relaxed) == before)
+        return totals;
+    }
+  }
+};
+
+/**
+ * SharedOperatorRewards of each AOS parameter prefix, so that the workers of
+ * a parallel algorithm share the rewards of their matching AOS. Rewards are
+ * created while the workers are built, before they run.
+ */
+class SharedOperatorRewardsRegistry {
+  const int maxWorkers;
+  std::map<std::string, std::unique_ptr<SharedOperatorRewards>> rewards;
+
+ public:
+  explicit SharedOperatorRewardsRegistry(int maxWorkers)
+      : maxWorkers{maxWorkers} {}
+
+  auto get(const std::string& prefix, int noOperators)
+      -> SharedOperatorRewards& {
+    auto& shared = rewards[prefix];
+    if (!shared)
+      shared = std::make_unique<SharedOperatorRewards>(noOperators, maxWorkers);
+    if (shared->noOperators() != noOperators)
+      throw std::runtime_error("Shared AOS " + prefix +
+                               " built with different operators");
+    return *shared;
+  }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Fenwick tree of non-negative weights. Changing a weight, computing the
+ * total and finding the index where a cumulative weight falls are O(log K),
+ * so sampling an index with probability proportional to its weight does not
+ * scan all of them.
+ */
+class SumTree {
+  std::vector<double> tree;
+  std::vector<double> weights;
+  int highestBit = 0;
+
+ public:
+  explicit SumTree(int size = 0) { assign(std::vector<double>(size, 0.0)); }
+
+  /** Replaces all weights in O(K). */
+  void assign(const std::vector<double>& values) {
+    weights = values;
+    const int n = weights.size();
+    tree.assign(n + 1, 0.0);
+    for (int i = 1; i <= n; i++) {
+      tree[i] += weights[i - 1];
+      const int parent = i + (i & -i);
+      if (parent <= n)
+        tree[parent] += tree[i];
+    }
+    highestBit = 1;
+    while (highestBit * 2 <= n)
+      highestBit *= 2;
+  }
+
+  [[nodiscard]] auto size() const -> int { return weights.size(); }
+
+  [[nodiscard]] auto operator[](int i) const -> double { return weights[i]; }
+
+  void set(int i, double weight) {
+    const double delta = weight - weights[i];
+    weights[i] = weight;
+    for (int j = i + 1; j < static_cast<int>(tree.size()); j += j & -j)
+      tree[j] += delta;
+  }
+
+  [[nodiscard]] auto total() const -> double {
+    double sum = 0.0;
+    for (int j = size(); j > 0; j -= j & -j)
+      sum += tree[j];
+    return sum;
+  }
+
+  /**
+   * Smallest index whose cumulative weight exceeds `target`, for target in
+   * [0, total()). Indices with zero weight are never returned.
+   */
+  [[nodiscard]] auto find(double target) const -> int {
+    int pos = 0;
+    for (int step = highestBit; step > 0; step /= 2) {
+      const int next = pos + step;
+      if (next <= size() && tree[next] <= target) {
+        pos = next;
+        target -= tree[next];
+      }
+    }
+    // rounding may end past the last positive weight
+    while (pos > 0 && (pos == size() || weights[pos] <= 0.0))
+      pos--;
+    return pos;
+  }
+};
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <random>
+#include <utility>
 #include <vector>
 
 #include "flowshop-solver/aos/adaptive_operator_selection.hpp"
-#include "flowshop-solver/aos/beta_distribution.hpp"
+#include "flowshop-solver/aos/gamma_sampler.hpp"
 #include "flowshop-solver/global.hpp"
 
+/**
+ * Beta-Bernoulli Thompson sampling. A Beta(a, b) sample is X / (X + Y) with
+ * X ~ Gamma(a) and Y ~ Gamma(b); the gamma samplers of each operator keep
+ * their constants until its counts change, and all operators are sampled in
+ * one pass over the engine of the calling thread.
+ */
 template <class OpT>
 class ThompsonSampling : public OperatorSelection<OpT> {
  protected:
@@ -14,20 +22,64 @@ class ThompsonSampling : public OperatorSelection<OpT> {
   int              noSamples;
   int              opIdx = 0;
 
+  std::vector<GammaSampler> alphaGammas;
+  std::vector<GammaSampler> betaGammas;
+  std::vector<double> samples;
+  std::normal_distribution<double> normal;
+
   using OperatorSelection<OpT>::noOperators;
 
+  /** Adds a binary reward to the counts of operator i. */
+  virtual void record(int i, int reward) {
+    alphas[i] = alphas[i] + reward;
+    betas[i] = betas[i] + (1 - reward);
+  }
+
+  void observe(int op, const SharedOperatorRewards::Totals& delta) override {
+    for (long j = 0; j < delta.positives; j++)
+      record(op, 1);
+    for (long j = delta.positives; j < delta.count; j++)
+      record(op, 0);
+    refresh(op);
+  }
+
+  /** Updates the samplers of operator i after its counts changed. */
+  void refresh(int i) {
+    alphaGammas[i].set(alphas[i]);
+    betaGammas[i].set(betas[i]);
+  }
+
+  void writeState(std::ostream& os) const override {
+    this->writeValues(os, alphas);
+    this->writeValues(os, betas);
+  }
+
+  auto readState(std::istream& is) -> bool override {
+    auto savedAlphas = this->template readValues<double>(is, noOperators());
+    auto savedBetas = this->template readValues<double>(is, noOperators());
+    alphas = std::move(savedAlphas);
+    betas = std::move(savedBetas);
+    for (int i = 0; i < noOperators(); i++)
+      refresh(i);
+    return true;
+  }
+
   auto selectOperatorIdx() -> int override {
+    auto& engine = RNG::localEngine();
+    samples.assign(noOperators(), 0.0);
+    for (int j = 0; j < noSamples; j++) {
+      for (int i = 0; i < noOperators(); i++) {
+        const double x = alphaGammas[i](engine, normal);
+        const double y = betaGammas[i](engine, normal);
+        samples[i] += x / (x + y) / noSamples;
+      }
+    }
     opIdx            = 0;
     double maxSample = 0.0;
     for (int i = 0; i < noOperators(); i++) {
-      beta_distribution<double> dist(alphas[i], betas[i]);
-      double                    meanSample = 0;
-      for (int j = 0; j < noSamples; j++) {
-        meanSample += dist(RNG::engine) / noSamples;
-      }
-      if (meanSample > maxSample) {
+      if (samples[i] > maxSample) {
         opIdx     = i;
-        maxSample = meanSample;
+        maxSample = samples[i];
       }
     }
     return opIdx;
@@ -38,14 +90,15 @@ class ThompsonSampling : public OperatorSelection<OpT> {
       : OperatorSelection<OpT>{strategies},
         alphas(strategies.size(), 1),
         betas(strategies.size(), 1),
-        noSamples{1} {}
+        noSamples{1},
+        alphaGammas(strategies.size(), GammaSampler(1.0)),
+        betaGammas(strategies.size(), GammaSampler(1.0)) {}
 
   void update() override{};
 
   void doFeedback(double fb) override {
-    int reward = fb > 0;
-    alphas[opIdx] = alphas[opIdx] + reward;
-    betas[opIdx] = betas[opIdx] + (1 - reward);
+    record(opIdx, fb > 0);
+    refresh(opIdx);
   }
 
   auto printOn(std::ostream& os) -> std::ostream& final {
@@ -54,9 +107,12 @@ class ThompsonSampling : public OperatorSelection<OpT> {
     return os;
   }
 
+  /** Back to the uniform Beta(1, 1) prior of every operator. */
   void reset(double) override {
-    alphas.assign(noOperators(), 0);
-    betas.assign(noOperators(), 0);
+    alphas.assign(noOperators(), 1);
+    betas.assign(noOperators(), 1);
+    for (int i = 0; i < noOperators(); i++)
+      refresh(i);
   }
 };
 
@@ -68,22 +124,20 @@ class DynamicThompsonSampling : public ThompsonSampling<OpT> {
  protected:
   using ThompsonSampling<OpT>::alphas;
   using ThompsonSampling<OpT>::betas;
-  using ThompsonSampling<OpT>::opIdx;
+
+  void record(int i, int reward) override {
+    if (alphas[i] + betas[i] < threshold) {
+      alphas[i] = alphas[i] + reward;
+      betas[i] = betas[i] + (1 - reward);
+    } else {
+      alphas[i] = (alphas[i] + reward) * scale;
+      betas[i] = (betas[i] + (1 - reward)) * scale;
+    }
+  }
 
  public:
   DynamicThompsonSampling(const std::vector<OpT>& strategies, int threshold = 1)
       : ThompsonSampling<OpT>{strategies},
         threshold{threshold},
         scale{threshold / (threshold + 1.0)} {}
-
-  void doFeedback(double fb) override {
-    int reward = fb > 0;
-    if (alphas[opIdx] + betas[opIdx] < threshold) {
-      alphas[opIdx] = alphas[opIdx] + reward;
-      betas[opIdx] = betas[opIdx] + (1 - reward);
-    } else {
-      alphas[opIdx] = (alphas[opIdx] + reward) * scale;
-      betas[opIdx] = (betas[opIdx] + (1 - reward)) * scale;
-    }
-  }
 };
@@ -33,9 +33,12 @@
 
 #include "flowshop-solver/heuristics/AdaptivePerturb.hpp"
 #include "flowshop-solver/heuristics/BestInsertionExplorer.hpp"
+#include "flowshop-solver/heuristics/CriticalBlockExplorer.hpp"
 #include "flowshop-solver/heuristics/perturb/IGLocalSearchPartialSolution.hpp"
+#include "flowshop-solver/heuristics/perturb/PartialSolutionLocalSearch.hpp"
 
 #include "flowshop-solver/heuristics/AppendingNEH.hpp"
+#include "flowshop-solver/heuristics/BeamSearch.hpp"
 
 #include "flowshop-solver/number-of-swaps/NumberOfSwaps.hpp"
 #include "flowshop-solver/number-of-swaps/FixedNumberOfSwaps.hpp"
@@ -125,12 +128,41 @@ class eoFSPFactory : public eoFactory<FSPProblem::Ngh> {
                                           ratio);
         }
       }
+    } else if (name == "beam") {
+      auto order =
+          buildPriority(_problem.data(), categoricalName(".Init.Beam.Priority"),
+                        categoricalName(".Init.Beam.PriorityWeighted") == "yes",
+                        categoricalName(".Init.Beam.PriorityOrder"))
+              .release();
+      storeFunctor(order);
+      const int width = std::stoi(categoricalName(".Init.Beam.Width"));
+      const int noThreads =
+          std::stoi(categoricalName(".Init.Beam.Threads", "1"));
+      return &pack<BeamSearchInit>(_problem, *order, width, noThreads);
     }
     return nullptr;
   }
 
-  auto buildLSPSLocalSearch() -> myResizableLocalSearch<Ngh>* {
-    auto neighborhood = buildNeighborhood(_problem.maxNeighborhoodSize());
+  auto domainLocalSearch(const std::string& name)
+      -> moLocalSearch<Ngh>* override {
+    if (name == "critical_block_insertion") {
+      if (_problem.type() != "PERM" || _problem.objective() != "MAKESPAN")
+        throw std::runtime_error(
+            "critical_block_insertion is only available for PERM MAKESPAN, "
+            "not " +
+            _problem.type() + " " + _problem.objective());
+      auto compNN = buildNeighborComparator();
+      auto compSN = buildSolNeighborComparator();
+      auto explorer = &pack<CriticalBlockExplorer<EOT>>(
+          _problem.data(), _problem.neighborEval(),
+          _problem.neighborhoodCheckpoint(), *compNN, *compSN);
+      return &pack<moLocalSearch<Ngh>>(*explorer, _problem.checkpoint(),
+                                       _problem.eval());
+    }
+    return nullptr;
+  }
+
+  auto buildLSPSLocalSearch() -> PartialSolutionLocalSearch<EOT>* {
     auto compNN = buildNeighborComparator();
     auto compSN = buildSolNeighborComparator();
     auto& eval = _problem.eval();
@@ -138,8 +170,15 @@ class eoFSPFactory : public eoFactory<FSPProblem::Ngh> {
     auto& cp = _problem.continuator();
     auto& nghCp = _problem.neighborhoodCheckpoint();
 
-    moLocalSearch<Ngh>* localSearch = nullptr;
     const std::string name = categoricalName(".LSPS.Local.Search");
+    if (name == "partial_best_insertion") {
+      const bool singleStep = categoricalName(".LSPS.Single.Step") == "1";
+      return &pack<PartialInsertionLocalSearch<Ngh>>(nEval, *compNN, *compSN,
+                                                     cp, singleStep);
+    }
+
+    auto neighborhood = buildNeighborhood(_problem.maxNeighborhoodSize());
+    moLocalSearch<Ngh>* localSearch = nullptr;
     if (name == "none") {
       localSearch = &pack<moDummyLS<Ngh>>(eval);
     } else if (name == "first_improvement") {
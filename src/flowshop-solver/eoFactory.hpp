@@ -18,10 +18,14 @@
 
 // AOS
 #include "flowshop-solver/aos/EpsilonGreedy.hpp"
+#include "flowshop-solver/aos/aos_state.hpp"
+#include "flowshop-solver/aos/aos_trace.hpp"
 #include "flowshop-solver/aos/frrmab.hpp"
 #include "flowshop-solver/aos/lin_ucb.hpp"
+#include "flowshop-solver/aos/operator_cost.hpp"
 #include "flowshop-solver/aos/probability_matching.hpp"
 #include "flowshop-solver/aos/random.hpp"
+#include "flowshop-solver/aos/shared_rewards.hpp"
 #include "flowshop-solver/aos/thompson_sampling.hpp"
 
 // Online FLA
@@ -35,6 +39,10 @@
 #include "flowshop-solver/neighborhood-size/FixedNeighborhoodSize.hpp"
 #include "flowshop-solver/neighborhood-size/NeighborhoodSize.hpp"
 
+#include "flowshop-solver/insertion-window/AdaptiveInsertionWindow.hpp"
+#include "flowshop-solver/insertion-window/FixedInsertionWindow.hpp"
+#include "flowshop-solver/insertion-window/InsertionWindow.hpp"
+
 #include "aos/thompson_sampling.hpp"
 
 #include "flowshop-solver/heuristics/AdaptiveLocalSearch.hpp"
@@ -59,6 +67,12 @@ template <class Ngh, class EOT = typename Ngh::EOT>
 class eoFactory : public eoFunctorStore {
   const MHParamsValues& _params;
   Problem<Ngh>& _problem;
+  SharedOperatorRewardsRegistry* sharedRewards = nullptr;
+  int sharedRewardsPeriod = 1;
+  AOSTraceWriter* aosTrace = nullptr;
+  AOSStateStore* aosStates = nullptr;
+  std::string aosFeatures;
+  bool aosWarmStart = false;
 
  protected:
   virtual auto domainInit() -> eoInit<EOT>* { return nullptr; }
@@ -70,7 +84,9 @@ class eoFactory : public eoFunctorStore {
     return nullptr;
   }
 
-  virtual auto domainLocalSearch() -> moLocalSearch<Ngh>* { return nullptr; }
+  virtual auto domainLocalSearch(const std::string&) -> moLocalSearch<Ngh>* {
+    return nullptr;
+  }
 
   virtual auto domainPerturb() -> moPerturbation<Ngh>* { return nullptr; }
 
@@ -91,6 +107,15 @@ class eoFactory : public eoFunctorStore {
   eoFactory(const MHParamsValues& params, Problem<Ngh>& problem)
       : _params{params}, _problem{problem} {};
 
+  eoFactory(const eoFactory&) = delete;
+  auto operator=(const eoFactory&) -> eoFactory& = delete;
+
+  /** The persisted operator selections die with the factory. */
+  ~eoFactory() {
+    if (aosStates != nullptr)
+      aosStates->release(this);
+  }
+
   [[nodiscard]] auto params() const -> const MHParamsValues& { return _params; }
 
   auto problem() const -> const Problem<Ngh>& { return _problem; }
@@ -100,6 +125,12 @@ class eoFactory : public eoFunctorStore {
     return _params.categoricalName(_params.mhName() + name);
   }
 
+  [[nodiscard]] auto categoricalName(const std::string& name,
+                                     const std::string& def) const
+      -> std::string {
+    return _params.categoricalName(_params.mhName() + name, def);
+  }
+
   [[nodiscard]] auto categorical(const std::string& name) const -> int {
     return _params.categorical(_params.mhName() + name);
   }
@@ -114,9 +145,55 @@ class eoFactory : public eoFunctorStore {
 
   void params(MHParamsValues& _params) { this->_params = _params; }
 
+  /**
+   * Operator selections built from now on share their rewards with the ones
+   * of the same prefix built by other factories using `registry`, merging
+   * every `period` feedbacks.
+   */
+  void shareOperatorSelection(SharedOperatorRewardsRegistry& registry,
+                              int period) {
+    sharedRewards = &registry;
+    sharedRewardsPeriod = period;
+  }
+
+  /** Operator selections built from now on record their events in `trace`. */
+  void traceOperatorSelection(AOSTraceWriter& trace) {
+    aosTrace = &trace;
+  }
+
+  [[nodiscard]] auto operatorSelectionTrace() const -> AOSTraceWriter* {
+    return aosTrace;
+  }
+
+  /**
+   * Operator selections built from now on by `other`, e.g. the factory of a
+   * concurrent branch on a problem copy, are traced and persisted like the
+   * ones of this factory.
+   */
+  void forwardOperatorSelection(eoFactory& other) const {
+    other.aosTrace = aosTrace;
+    other.aosStates = aosStates;
+    other.aosFeatures = aosFeatures;
+    other.aosWarmStart = aosWarmStart;
+  }
+
+  /**
+   * Operator selections built from now on keep their state in `store`, under
+   * the instance `features`, the parameter prefix and the strategy. With
+   * `warmStart`, they continue from the stored states and skip the warm-up.
+   */
+  void persistOperatorSelection(AOSStateStore& store,
+                                const std::string& features,
+                                bool warmStart) {
+    aosStates = &store;
+    aosFeatures = features;
+    aosWarmStart = warmStart;
+  }
+
+  /** Initial solutions, random permutations when there is no `.Init`. */
   auto buildInit() -> eoInit<EOT>* {
     eoInit<EOT>* init = nullptr;
-    if (categoricalName(".Init") == "random")
+    if (categoricalName(".Init", "random") == "random")
       init = &pack<eoInitPermutation<EOT>>(_problem.size(0));
     else {
       init = domainInit();
@@ -239,6 +316,36 @@ class eoFactory : public eoFunctorStore {
     return nullptr;
   }
 
+  auto buildInsertionWindow() -> InsertionWindow<EOT>* {
+    const std::string name = categoricalName(".Insertion.Window", "full");
+    if (name == "full")
+      return nullptr;
+    const int noJobs = _problem.size(0);
+    const int halfWidth =
+        std::max(1, static_cast<int>(noJobs * real(".Insertion.Window.Size")));
+    if (name == "fixed") {
+      return &pack<FixedInsertionWindow<EOT>>(halfWidth);
+    } else if (name == "adaptive") {
+      return &pack<AdaptiveInsertionWindow<EOT>>(halfWidth, 1, noJobs);
+    }
+    throw std::runtime_error("unknown insertion window: " + name);
+    return nullptr;
+  }
+
+  /**
+   * Whether the local search `name` draws from ParadisEO's global generator
+   * (random neighborhoods and moRandomBestHC), so that it cannot run in
+   * concurrent threads.
+   */
+  [[nodiscard]] auto localSearchUsesGlobalRNG(const std::string& name) const
+      -> bool {
+    if (name == "random_best_improvement" || name == "adaptive" ||
+        name == "adaptive_with_adaptive_best_insertion")
+      return true;
+    return (name == "first_improvement" || name == "best_improvement") &&
+           categoricalName(".Neighborhood.Strat", "ordered") != "ordered";
+  }
+
   auto buildLocalSearchByName(const std::string& name, bool singleStep)
       -> moLocalSearch<Ngh>* {
     auto compNN = buildNeighborComparator();
@@ -267,7 +374,8 @@ class eoFactory : public eoFunctorStore {
     } else if (name == "best_insertion") {
       auto neighborhoodSize = buildNeighborhoodSize();
       auto explorer = &pack<BestInsertionExplorer<EOT>>(
-          nEval, nghCp, *compNN, *compSN, *neighborhoodSize);
+          nEval, nghCp, *compNN, *compSN, *neighborhoodSize,
+          NeighborhoodType::random, buildInsertionWindow());
       ret = &pack<moLocalSearch<Ngh>>(*explorer, cp, eval);
     } else if (name == "adaptive") {
       std::vector<moLocalSearch<Ngh>*> localSearches = {
@@ -302,7 +410,7 @@ class eoFactory : public eoFunctorStore {
                                              rewardType, *operatorSelection, cp,
                                              eval);
     } else {
-      return domainLocalSearch();
+      return domainLocalSearch(name);
     }
 
     if (singleStep) {
@@ -372,6 +480,26 @@ class eoFactory : public eoFunctorStore {
         pack<moIterContinuator<OperatorSelection<int>::DummyNgh>>(
             warmUpProportion, false);
     strategy->setWarmUp(warmUpContinuator, warmUpStrategy, 0);
+    const std::string cost = categoricalName(prefix + ".AOS.Cost", "none");
+    if (cost == "time") {
+      strategy->chargeCost(pack<TimeCost>());
+    } else if (cost == "evaluations") {
+      strategy->chargeCost(pack<EvaluationCost<Problem<Ngh>>>(_problem));
+    } else if (cost != "none") {
+      throw std::runtime_error("unknown AOS cost: " + cost);
+    }
+    if (sharedRewards != nullptr)
+      strategy->share(sharedRewards->get(prefix, options.size()),
+                      sharedRewardsPeriod);
+    if (aosTrace != nullptr)
+      strategy->trace(*aosTrace);
+    if (aosStates != nullptr) {
+      const std::string key =
+          aosFeatures + '/' + _params.mhName() + prefix + '/' + name;
+      if (aosWarmStart)
+        aosStates->restore(key, *strategy);
+      aosStates->track(key, *strategy, this);
+    }
 
     return strategy;
   }
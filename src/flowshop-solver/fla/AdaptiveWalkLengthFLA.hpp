@@ -1,7 +1,5 @@
 #pragma once
 
-#include <iterator>
-
 #include "flowshop-solver/fla/FitnessHistoryFLA.hpp"
 
 template <class EOT>
@@ -9,14 +7,8 @@ class AdaptiveWalkLengthFLA : public FitnessHistoryFLA<EOT> {
   double scale = 1.0;
 
  public:
-  AdaptiveWalkLengthFLA(const FitnessHistory<EOT>& fitnessHistory, double scale)
+  AdaptiveWalkLengthFLA(FitnessHistory<EOT>& fitnessHistory, double scale)
       : FitnessHistoryFLA<EOT>{fitnessHistory}, scale{scale} {}
 
- protected:
-  using citerator = typename FitnessHistory<EOT>::citerator;
-
-  double compute(citerator begin, citerator end) override {
-    const int n = std::distance(begin, end);
-    return n * scale;
-  }
-};
\ No newline at end of file
+  double compute() override { return this->fitnessHistory.size() * scale; }
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/** Number of permutations with each fitness value. */
+class FitnessHistogram {
+  std::map<long, unsigned long> bins;
+
+ public:
+  void operator()(const std::vector<long>& values) {
+    for (long value : values)
+      bins[value]++;
+  }
+
+  [[nodiscard]] auto counts() const -> const std::map<long, unsigned long>& {
+    return bins;
+  }
+};
+
+/**
+ * Binary file of fitness values written in chunks. Each chunk holds its
+ * number of values followed by the differences between consecutive values,
+ * all as zigzag varints, so the small differences between neighboring
+ * permutations of an enumeration take one or two bytes.
+ */
+class FitnessFileWriter {
+  std::ofstream out;
+  std::string buffer;
+
+  void put(std::uint64_t x) {
+    while (x >= 0x80) {
+      buffer.push_back(static_cast<char>(x | 0x80));
+      x >>= 7;
+    }
+    buffer.push_back(static_cast<char>(x));
+  }
+
+ public:
+  static constexpr char magic[4] = {'F', 'S', 'P', 'F'};
+
+  explicit FitnessFileWriter(const std::string& filename)
+      : out(filename, std::ios::binary) {
+    if (!out)
+      throw std::runtime_error("Could not open " + filename);
+    out.write(magic, sizeof(magic));
+  }
+
+  void operator()(const std::vector<long>& values) {
+    buffer.clear();
+    put(values.size());
+    long previous = 0;
+    for (long value : values) {
+      const std::int64_t delta = value - previous;
+      put((static_cast<std::uint64_t>(delta) << 1) ^
+          static_cast<std::uint64_t>(delta >> 63));
+      previous = value;
+    }
+    out.write(buffer.data(), buffer.size());
+  }
+};
+
+/** Calls onValue for every value of a file written by FitnessFileWriter. */
+template <class OnValue>
+void readFitnessFile(const std::string& filename, OnValue onValue) {
+  std::ifstream in(filename, std::ios::binary);
+  char header[4];
+  if (!in.read(header, sizeof(header)) ||
+      !std::equal(header, header + 4, FitnessFileWriter::magic))
+    throw std::runtime_error("Not a fitness file: " + filename);
+  const auto get = [&](std::uint64_t& x) {
+    x = 0;
+    for (int shift = 0;; shift += 7) {
+      const int c = in.get();
+      if (c == EOF)
+        return false;
+      x |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+      if ((c & 0x80) == 0)
+        return true;
+    }
+  };
+  std::uint64_t size = 0;
+  while (get(size)) {
+    long value = 0;
+    for (std::uint64_t i = 0; i < size; i++) {
+      std::uint64_t x = 0;
+      if (!get(x))
+        throw std::runtime_error("Truncated fitness file: " + filename);
+      value += static_cast<long>((x >> 1) ^ (~(x & 1) + 1));
+      onValue(value);
+    }
+  }
+}
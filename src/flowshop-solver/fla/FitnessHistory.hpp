@@ -1,24 +1,110 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include <paradiseo/mo/mo>
 
+/**
+ * Running statistics of the fitness values of a search, in constant memory:
+ * Welford mean and variance, the index weighted sum used by the
+ * fitness-distance correlation and, for each lag registered with trackLag(),
+ * the sum of lagged products. Only the first and the last maxLag values are
+ * kept. Values are shifted by the first one to limit cancellation.
+ */
 template <class EOT>
 class FitnessHistory : public moStatBase<EOT> {
-  std::vector<double> fitness;
+  long n = 0;
+  double shift = 0.0;
+  double mean_ = 0.0;
+  double m2 = 0.0;
+  double sum = 0.0;
+  double indexedSum = 0.0;
+  double last = 0.0;
+  int maxLag = 0;
+  // prefix sums of the first maxLag values
+  std::vector<double> head;
+  // last maxLag values, value i at i % maxLag
+  std::vector<double> recent;
+  // lagProducts[k - 1] = sum of y_i y_{i + k}
+  std::vector<double> lagProducts;
+
+  [[nodiscard]] auto recentValue(long i) const -> double {
+    return recent[i % maxLag];
+  }
 
  public:
-  using citerator = typename std::vector<double>::const_iterator;
+  /** Keeps the sums for lag k, must be called before the first value. */
+  void trackLag(int k) {
+    if (k <= maxLag)
+      return;
+    maxLag = k;
+    head.assign(maxLag, 0.0);
+    recent.assign(maxLag, 0.0);
+    lagProducts.assign(maxLag, 0.0);
+  }
+
+  void init(EOT&) final {
+    n = 0;
+    shift = mean_ = m2 = sum = indexedSum = last = 0.0;
+    std::fill(head.begin(), head.end(), 0.0);
+    std::fill(lagProducts.begin(), lagProducts.end(), 0.0);
+  }
+
+  void operator()(EOT& sol) final { push(sol.fitness()); }
+
+  void push(double fitness) {
+    if (n == 0)
+      shift = fitness;
+    const double y = fitness - shift;
+    const double delta = y - mean_;
+    mean_ += delta / (n + 1);
+    m2 += delta * (y - mean_);
+    sum += y;
+    indexedSum += n * y;
+    last = y;
+    if (maxLag > 0) {
+      for (long k = 1; k <= std::min<long>(maxLag, n); k++)
+        lagProducts[k - 1] += y * recentValue(n - k);
+      if (n < maxLag)
+        head[n] = (n > 0 ? head[n - 1] : 0.0) + y;
+      recent[n % maxLag] = y;
+    }
+    n++;
+  }
 
-  FitnessHistory() { fitness.reserve(100); }
+  [[nodiscard]] auto size() const -> long { return n; }
 
-  void init(EOT&) final { fitness.clear(); }
+  [[nodiscard]] auto mean() const -> double { return shift + mean_; }
 
-  void operator()(EOT& sol) final { fitness.push_back(sol.fitness()); }
+  /** Sample variance. */
+  [[nodiscard]] auto variance() const -> double {
+    return n > 1 ? m2 / (n - 1) : 0.0;
+  }
 
-  // void lastCall(EOT& sol) { std::cerr << printSeq(fitness) << '\n'; }
+  /** Sum of (x_i - mean)(x_{i + k} - mean) for i < n - k. */
+  [[nodiscard]] auto autocovarianceSum(int k) const -> double {
+    if (k <= 0 || k > maxLag || n <= k)
+      return 0.0;
+    double tail = 0.0;
+    for (long j = 1; j <= k; j++)
+      tail += recentValue(n - j);
+    const double leading = sum - tail;
+    const double trailing = sum - head[k - 1];
+    return lagProducts[k - 1] - mean_ * (leading + trailing) +
+           (n - k) * mean_ * mean_;
+  }
 
-  citerator cbegin() const { return fitness.cbegin(); }
-  citerator cend() const { return fitness.cend(); }
-};
\ No newline at end of file
+  /**
+   * Sum of (x_i - mean)(n / 2 - i) for i < n - 1, where n - i is the
+   * distance of x_i to the last value.
+   */
+  [[nodiscard]] auto distanceCovarianceSum() const -> double {
+    if (n < 2)
+      return 0.0;
+    const double leading = sum - last - (n - 1) * mean_;
+    const double indexed =
+        indexedSum - (n - 1) * last - mean_ * (n - 1) * (n - 2) / 2.0;
+    return n / 2.0 * leading - indexed;
+  }
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "flowshop-solver/ThreadPool.hpp"
+#include "flowshop-solver/problems/FSPProblem.hpp"
+
+/**
+ * Evaluates every permutation of a problem and streams the fitness values in
+ * chunks, instead of keeping all n! of them.
+ *
+ * The space is split by prefix: with more than one thread, each prefix of two
+ * jobs is a task. The suffix of a task is enumerated with Heap's algorithm,
+ * applied from the end of the permutation, so each permutation differs from
+ * the previous one by a swap and only the positions from the first swapped
+ * one on change. For PERM problems, the completion times of the unchanged
+ * prefix are kept and only the changed suffix is evaluated, O(m) per
+ * permutation on average. Other types are fully evaluated.
+ */
+class PermutationEnumerator {
+  FSPProblem& problem;
+  const FSPData& data;
+  const int N;
+  const int M;
+  const bool incremental;
+  const bool flowtime;
+  const std::size_t chunkSize;
+
+  struct Task {
+    std::vector<int> perm;
+    // completion times of each position on each machine
+    std::vector<long> ct;
+    std::vector<long> flow;
+    std::unique_ptr<FSPEval> eval;
+    FSP sol;
+    std::vector<long> chunk;
+  };
+
+  /** Fitness of task.perm, whose positions before `from` did not change. */
+  auto evaluate(Task& task, int from) const -> long {
+    if (!incremental) {
+      task.sol.assign(task.perm.begin(), task.perm.end());
+      task.sol.invalidate();
+      (*task.eval)(task.sol);
+      return static_cast<long>(task.sol.fitness());
+    }
+    const auto& p = data.procTimesRef();
+    for (int i = from; i < N; i++) {
+      const int job = task.perm[i];
+      long* row = task.ct.data() + i * M;
+      const long* prev = i > 0 ? row - M : nullptr;
+      row[0] = (prev ? prev[0] : 0) + p[job];
+      for (int m = 1; m < M; m++)
+        row[m] = std::max(row[m - 1], prev ? prev[m] : 0) + p[m * N + job];
+      task.flow[i] = (i > 0 ? task.flow[i - 1] : 0) + row[M - 1];
+    }
+    return flowtime ? task.flow[N - 1] : task.ct[N * M - 1];
+  }
+
+  template <class Emit>
+  void enumerateSuffix(Task& task, int prefixSize, Emit& emit) const {
+    emit(evaluate(task, 0));
+    // Heap's algorithm on a[x] = perm[N - 1 - x]
+    const int k = N - prefixSize;
+    std::vector<int> c(k, 0);
+    int i = 1;
+    while (i < k) {
+      if (c[i] < i) {
+        const int j = i % 2 == 0 ? 0 : c[i];
+        std::swap(task.perm[N - 1 - j], task.perm[N - 1 - i]);
+        emit(evaluate(task, N - 1 - i));
+        c[i]++;
+        i = 1;
+      } else {
+        c[i] = 0;
+        i++;
+      }
+    }
+  }
+
+ public:
+  explicit PermutationEnumerator(FSPProblem& problem,
+                                 std::size_t chunkSize = 1 << 16)
+      : problem{problem},
+        data{problem.getData()},
+        N{data.noJobs()},
+        M{data.noMachines()},
+        incremental{problem.type() == "PERM"},
+        flowtime{problem.objective() == "FLOWTIME"},
+        chunkSize{std::max<std::size_t>(chunkSize, 1)} {}
+
+  /**
+   * Calls consume(const std::vector<long>&) with chunks of fitness values,
+   * one call at a time. With threads, chunks arrive in no particular order.
+   * Returns the number of permutations.
+   */
+  template <class Consume>
+  auto run(Consume&& consume, unsigned noThreads = 1) -> unsigned long {
+    const int prefixSize = noThreads > 1 ? std::min(2, N - 1) : 0;
+    std::vector<std::vector<int>> prefixes = {{}};
+    for (int d = 0; d < prefixSize; d++) {
+      std::vector<std::vector<int>> next;
+      for (const auto& prefix : prefixes) {
+        for (int job = 0; job < N; job++) {
+          if (std::find(prefix.begin(), prefix.end(), job) != prefix.end())
+            continue;
+          next.push_back(prefix);
+          next.back().push_back(job);
+        }
+      }
+      prefixes = std::move(next);
+    }
+
+    std::mutex mutex;
+    unsigned long total = 0;
+    const auto flush = [&](std::vector<long>& chunk) {
+      std::lock_guard<std::mutex> lock(mutex);
+      total += chunk.size();
+      consume(std::as_const(chunk));
+      chunk.clear();
+    };
+    const auto runTask = [&](unsigned t) {
+      Task task;
+      task.perm = prefixes[t];
+      for (int job = 0; job < N; job++)
+        if (std::find(prefixes[t].begin(), prefixes[t].end(), job) ==
+            prefixes[t].end())
+          task.perm.push_back(job);
+      if (incremental) {
+        task.ct.resize(static_cast<std::size_t>(N) * M);
+        task.flow.resize(N);
+      } else {
+        task.eval = problem.getEvalFunc(problem.type(), problem.objective());
+      }
+      task.chunk.reserve(chunkSize);
+      auto emit = [&](long value) {
+        task.chunk.push_back(value);
+        if (task.chunk.size() == chunkSize)
+          flush(task.chunk);
+      };
+      enumerateSuffix(task, prefixSize, emit);
+      if (!task.chunk.empty())
+        flush(task.chunk);
+    };
+
+    if (N == 0)
+      return 0;
+    if (prefixes.size() == 1) {
+      runTask(0);
+    } else {
+      ThreadPool pool(noThreads);
+      pool.parallelFor(prefixes.size(), runTask);
+    }
+    return total;
+  }
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -22,6 +23,8 @@
 #include "flowshop-solver/heuristics/ig.hpp"
 
 #include "flowshop-solver/eoFSPFactory.hpp"
+#include "flowshop-solver/fla/FitnessFile.hpp"
+#include "flowshop-solver/fla/PermutationEnumerator.hpp"
 
 
 std::vector<FSPProblem::EOT> adaptiveWalk(
@@ -144,6 +147,29 @@ std::vector<double> enumerateAll(
   return res;
 }
 
+/** Number of permutations with each fitness value, without storing them. */
+inline auto enumerateAllHistogram(
+    const std::unordered_map<std::string, std::string>& prob_params,
+    unsigned noThreads) -> std::map<long, unsigned long> {
+  FSPProblem problem = FSPProblemFactory::get(prob_params);
+  FitnessHistogram histogram;
+  PermutationEnumerator(problem).run(histogram, noThreads);
+  return histogram.counts();
+}
+
+/**
+ * Writes the fitness of every permutation to a file read by readFitnessFile.
+ * Returns the number of permutations.
+ */
+inline auto enumerateAllToFile(
+    const std::unordered_map<std::string, std::string>& prob_params,
+    const std::string& filename,
+    unsigned noThreads) -> unsigned long {
+  FSPProblem problem = FSPProblemFactory::get(prob_params);
+  FitnessFileWriter writer(filename);
+  return PermutationEnumerator(problem).run(writer, noThreads);
+}
+
 template <class Ngh, class EOT = typename Ngh::EOT>
 std::vector<EOT> enumerateAllSolutions(Problem<Ngh>& problem) {
   const int n = problem.size();
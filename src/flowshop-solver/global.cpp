@@ -2,6 +2,7 @@
 
 std::mt19937_64 RNG::engine;
 std::random_device RNG::true_rand_engine;
+thread_local RNG::Stream* RNG::threadStream = nullptr;
 long RNG::saved_seed = 0l;
 bool RNG::is_saved = false;
 std::unordered_map<int, long> RNG::SeedPool::seeds;
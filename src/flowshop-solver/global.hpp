@@ -151,18 +151,42 @@ struct Measure {
   }
 };
 
-template <class T = uint32_t>
-struct ParadiseoRNGFunctor {
-  using result_type = T;
-  auto operator()() -> T { return rng.rand(); }
-  auto min() -> T { return 0; }
-  auto max() -> T { return rng.rand_max(); }
-};
-
 struct RNG {
   static std::mt19937_64 engine;
   static std::random_device true_rand_engine;
 
+  /**
+   * Independent random stream for code running on a worker thread, bound with
+   * RNG::StreamGuard. Threads without a bound stream use the global
+   * generators.
+   */
+  struct Stream {
+    eoRng paradiseo;
+    std::mt19937_64 engine;
+
+    explicit Stream(long s) : paradiseo(uint32_t(s)), engine(s) {}
+  };
+
+  static thread_local Stream* threadStream;
+
+  struct StreamGuard {
+    Stream* previous;
+    explicit StreamGuard(Stream& stream) : previous{threadStream} {
+      threadStream = &stream;
+    }
+    ~StreamGuard() { threadStream = previous; }
+  };
+
+  /** ParadisEO generator of the calling thread. */
+  inline static auto paradiseo() -> eoRng& {
+    return threadStream != nullptr ? threadStream->paradiseo : rng;
+  }
+
+  /** Engine of the calling thread. */
+  inline static auto localEngine() -> std::mt19937_64& {
+    return threadStream != nullptr ? threadStream->engine : engine;
+  }
+
   static auto seed(long s = true_rand_engine()) -> long {
     // my own RNG
     engine.seed(s);
@@ -181,12 +205,12 @@ struct RNG {
   inline static auto realUniform(const RealT& from = 0.0, const RealT& to = 1.0)
       -> RealT {
     std::uniform_real_distribution<RealT> uniform_dist(from, to);
-    return uniform_dist(engine);
+    return uniform_dist(localEngine());
   }
 
   inline static auto intUniform(int from, int to) -> int {
     std::uniform_int_distribution<int> uniform_dist(from, to);
-    return uniform_dist(engine);
+    return uniform_dist(localEngine());
   }
 
   inline static auto intUniform(const int until = 100) -> int {
@@ -194,8 +218,8 @@ struct RNG {
   }
 
   inline static auto flipCoin() -> bool {
-    static std::bernoulli_distribution dist(0.5);
-    return dist(engine);
+    std::bernoulli_distribution dist(0.5);
+    return dist(localEngine());
   }
 
   static long saved_seed;
@@ -241,6 +265,14 @@ struct RNG {
   };
 };
 
+template <class T = uint32_t>
+struct ParadiseoRNGFunctor {
+  using result_type = T;
+  auto operator()() -> T { return RNG::paradiseo().rand(); }
+  auto min() -> T { return 0; }
+  auto max() -> T { return RNG::paradiseo().rand_max(); }
+};
+
 template <class T = std::string>
 auto tokenize(const T& s, char delim = ',') -> std::vector<T> {
   std::stringstream ss(s);
@@ -52,6 +52,22 @@ class myTimeFitnessPrinter : public moStatBase<EOT> {
   }
 };
 
+template <class Ngh, class EOT = typename Ngh::EOT>
+auto experimentResult(Problem<Ngh>& prob,
+                      const EOT& sol,
+                      double time,
+                      const RunOptions& options) -> Result {
+  Result res;
+  res.fitness = std::min(sol.fitness(), std::min(prob.bestSoFar().value().fitness(),
+                         prob.bestLocalSoFar().value().fitness()));
+  res.time = time;
+  res.no_evals = prob.noEvals();
+  if (options.printLastFitness) {
+    std::cout << static_cast<int>(res.fitness) << ',' << res.time << ',' << res.no_evals << '\n';
+  }
+  return res;
+}
+
 template <class Ngh, class EOT = typename Ngh::EOT>
 auto runExperiment(eoInit<EOT>& init,
                    moLocalSearch<Ngh>& algo,
@@ -81,15 +97,28 @@ auto runExperiment(eoInit<EOT>& init,
     prob.checkpointGlobal().lastCall(sol);
 
   });
-  Result res;
-  res.fitness = std::min(sol.fitness(), std::min(prob.bestSoFar().value().fitness(),
-                         prob.bestLocalSoFar().value().fitness()));
-  res.time = time;
-  res.no_evals = prob.noEvals();
-  if (options.printLastFitness) {
-    std::cout << static_cast<int>(res.fitness) << ',' << res.time << ',' << res.no_evals << '\n';
+  return experimentResult(prob, sol, time, options);
+}
+
+/**
+ * Runs a search that is not a moLocalSearch, e.g. a population of solutions.
+ * `search(sol)` leaves the best solution found in `sol` and drives the
+ * checkpoints of the problem itself.
+ */
+template <class Ngh, class Search, class EOT = typename Ngh::EOT>
+auto runSearchExperiment(Problem<Ngh>& prob,
+                         Search search,
+                         RunOptions options = RunOptions()) -> Result {
+  myTimeStat<EOT> timer;
+  myTimeFitnessPrinter<EOT> timeFitness{timer};
+  if (options.printBestFitness) {
+    std::puts("iteration,runtime,fitness");
+    prob.checkpointGlobal().add(timeFitness);
   }
-  return res;
+
+  EOT sol;
+  double time = Measure<>::execution([&]() { search(sol); });
+  return experimentResult(prob, sol, time, options);
 }
 
 inline auto getNhSize(int N, double proportion) -> int {
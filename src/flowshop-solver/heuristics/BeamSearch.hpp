@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/ThreadPool.hpp"
+#include "flowshop-solver/problems/FSPProblem.hpp"
+#include "flowshop-solver/problems/FSPProblemCopies.hpp"
+
+/**
+ * Beam search version of NEH. Jobs are taken in the order of `order` and
+ * inserted in every position of each of the (up to) `width` partial sequences
+ * of the beam, evaluated with the neighbor evaluation as in InsertBest (with
+ * Taillard's acceleration for PERM makespan).
+ *
+ * The 2 * width candidates with the best partial objective are ranked by that
+ * objective plus a lower bound on the jobs still to insert, computed from the
+ * completion times of the candidate on each machine (PERM problems only,
+ * other types use the partial objective). The best distinct ones form the
+ * next beam. With width 1, this is NEH with first best insertion, apart from
+ * the bound.
+ *
+ * With more than one thread, the beam sequences are expanded concurrently,
+ * each worker with its own copy of the problem.
+ */
+class BeamSearchInit : public eoInit<FSP> {
+  using Ngh = FSPNeighbor;
+  using EOT = FSP;
+
+  struct Candidate {
+    int beam;
+    int position;
+    double fitness;
+    double score;
+  };
+
+  FSPProblem& problem;
+  eoInit<EOT>& order;
+  const unsigned width;
+  const bool useBound;
+  const bool flowtime;
+  FSPProblemCopies copies;
+  std::unique_ptr<ThreadPool> pool;
+
+  // bound data of the jobs not yet inserted
+  std::vector<long> remaining;
+  std::vector<long> minTail;
+  std::vector<long> shortestLast;
+  std::vector<long> completion;
+
+  void expand(FSPProblem& prob,
+              const EOT& partial,
+              int beamIndex,
+              int job,
+              std::vector<Candidate>& out) {
+    EOT sol = partial;
+    sol.push_back(job);
+    sol.invalidate();
+    const int k = partial.size();
+    out.clear();
+    if (k == 0) {
+      prob.eval()(sol);
+      out.push_back({beamIndex, 0, static_cast<double>(sol.fitness()), 0.0});
+      return;
+    }
+    Ngh neighbor;
+    for (int position = 0; position <= k; position++) {
+      neighbor.set(k, position, k + 1);
+      neighbor.invalidate();
+      prob.neighborEval()(sol, neighbor);
+      out.push_back({beamIndex, position,
+                     static_cast<double>(neighbor.fitness()), 0.0});
+    }
+  }
+
+  void prepareBound(const EOT& jobs, int next) {
+    const FSPData& data = problem.getData();
+    const int N = data.noJobs();
+    const int M = data.noMachines();
+    const auto& p = data.procTimesRef();
+    remaining.assign(M, 0);
+    minTail.assign(M, std::numeric_limits<long>::max());
+    shortestLast.clear();
+    for (int i = next; i < static_cast<int>(jobs.size()); i++) {
+      const int job = jobs[i];
+      long tail = 0;
+      for (int m = M - 1; m >= 0; m--) {
+        remaining[m] += p[m * N + job];
+        minTail[m] = std::min(minTail[m], tail);
+        tail += p[m * N + job];
+      }
+      shortestLast.push_back(p[(M - 1) * N + job]);
+    }
+    std::sort(shortestLast.begin(), shortestLast.end());
+    std::partial_sum(shortestLast.begin(), shortestLast.end(),
+                     shortestLast.begin());
+  }
+
+  /** Partial objective plus a lower bound for the remaining jobs. */
+  auto score(const EOT& partial, int job, int position, double fitness)
+      -> double {
+    if (!useBound || shortestLast.empty())
+      return fitness;
+    const FSPData& data = problem.getData();
+    const int N = data.noJobs();
+    const int M = data.noMachines();
+    const auto& p = data.procTimesRef();
+    completion.assign(M, 0);
+    const int size = partial.size() + 1;
+    for (int i = 0; i < size; i++) {
+      const int j = i == position ? job : partial[i < position ? i : i - 1];
+      long prev = 0;
+      for (int m = 0; m < M; m++) {
+        completion[m] = std::max(completion[m], prev) + p[m * N + j];
+        prev = completion[m];
+      }
+    }
+    if (flowtime) {
+      const long last = completion[M - 1];
+      long bound = 0;
+      for (long sum : shortestLast)
+        bound += last + sum;
+      return fitness + bound;
+    }
+    long bound = 0;
+    for (int m = 0; m < M; m++)
+      bound = std::max(bound, completion[m] + remaining[m] + minTail[m]);
+    return std::max(fitness, static_cast<double>(bound));
+  }
+
+ public:
+  BeamSearchInit(FSPProblem& problem,
+                 eoInit<EOT>& order,
+                 unsigned width,
+                 unsigned noThreads = 1)
+      : problem{problem},
+        order{order},
+        width{std::max(width, 1u)},
+        useBound{problem.type() == "PERM"},
+        flowtime{problem.objective() == "FLOWTIME"},
+        copies{problem, noThreads > 1 ? noThreads : 0u} {
+    if (noThreads > 1)
+      pool = std::make_unique<ThreadPool>(noThreads);
+  }
+
+  void operator()(EOT& sol) override {
+    EOT jobs = sol;
+    order(jobs);
+    const int N = jobs.size();
+    std::vector<EOT> beam(1), next;
+    std::vector<std::vector<Candidate>> expansions;
+    std::vector<Candidate> candidates;
+    std::vector<double> fitnesses(1);
+
+    for (int k = 0; k < N; k++) {
+      const int job = jobs[k];
+      expansions.resize(beam.size());
+      if (!pool) {
+        for (unsigned b = 0; b < beam.size(); b++)
+          expand(problem, beam[b], b, job, expansions[b]);
+      } else {
+        copies.sync();
+        pool->parallelFor(copies.size(), [&](unsigned w) {
+          for (unsigned b = w; b < beam.size(); b += copies.size())
+            expand(copies[w], beam[b], b, job, expansions[b]);
+        });
+        copies.merge();
+      }
+
+      candidates.clear();
+      for (unsigned b = 0; b < beam.size(); b++)
+        candidates.insert(candidates.end(), expansions[b].begin(),
+                          expansions[b].end());
+      std::stable_sort(candidates.begin(), candidates.end(),
+                       [](const Candidate& a, const Candidate& b) {
+                         return a.fitness < b.fitness;
+                       });
+      candidates.resize(std::min<std::size_t>(2 * width, candidates.size()));
+      prepareBound(jobs, k + 1);
+      for (auto& c : candidates)
+        c.score = score(beam[c.beam], job, c.position, c.fitness);
+      std::stable_sort(candidates.begin(), candidates.end(),
+                       [](const Candidate& a, const Candidate& b) {
+                         return std::tie(a.score, a.fitness) <
+                                std::tie(b.score, b.fitness);
+                       });
+
+      next.clear();
+      fitnesses.clear();
+      for (const auto& c : candidates) {
+        EOT candidate = beam[c.beam];
+        candidate.insert(candidate.begin() + c.position, job);
+        const auto same = [&](const EOT& other) {
+          return std::equal(other.begin(), other.end(), candidate.begin());
+        };
+        if (std::any_of(next.begin(), next.end(), same))
+          continue;
+        next.push_back(std::move(candidate));
+        fitnesses.push_back(c.fitness);
+        if (next.size() == width)
+          break;
+      }
+      std::swap(beam, next);
+    }
+
+    const auto best = std::distance(
+        fitnesses.begin(), std::min_element(fitnesses.begin(), fitnesses.end()));
+    sol = beam[best];
+    sol.fitness(fitnesses[best]);
+  }
+};
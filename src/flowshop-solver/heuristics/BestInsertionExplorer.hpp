@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <vector>
 
 #include <paradiseo/mo/mo>
 
 #include "flowshop-solver/global.hpp"
 #include "flowshop-solver/heuristics/neighborhood_checkpoint.hpp"
+#include "flowshop-solver/insertion-window/InsertionWindow.hpp"
 #include "flowshop-solver/problems/FSP.hpp"
 #include "flowshop-solver/neighborhood-size/NeighborhoodSize.hpp"
 
@@ -39,6 +42,9 @@ class BestInsertionExplorer
   unsigned k;
   NeighborhoodSize& neighborhoodSize;
   const NeighborhoodType neighborhoodType;
+  InsertionWindow<EOT> fullWindow;
+  InsertionWindow<EOT>& insertionWindow;
+  std::vector<int> positions;
 
  public:
   BestInsertionExplorer(
@@ -47,14 +53,17 @@ class BestInsertionExplorer
       moNeighborComparator<Ngh>& neighborComparator,
       moSolNeighborComparator<Ngh>& solNeighborComparator,
       NeighborhoodSize& neighborhoodSize,
-      NeighborhoodType neighborhoodType = NeighborhoodType::random)
+      NeighborhoodType neighborhoodType = NeighborhoodType::random,
+      InsertionWindow<EOT>* insertionWindow = nullptr)
       : moNeighborhoodExplorer<Ngh>{},
         neighborhoodCheckpoint{neighborhoodCheckpoint},
         neighborComparator{neighborComparator},
         solNeighborComparator{solNeighborComparator},
         neighborEval{neighborEval},
         neighborhoodSize(neighborhoodSize),
-        neighborhoodType{neighborhoodType} {}
+        neighborhoodType{neighborhoodType},
+        insertionWindow{insertionWindow != nullptr ? *insertionWindow
+                                                   : fullWindow} {}
 
   void initParam(EOT& _solution) final {
     improve = false;
@@ -98,7 +107,9 @@ class BestInsertionExplorer
     // Ngh neighbor, bestNeighbor;
     // bestNeighbor.fitness(std::numeric_limits<double>::max());
     neighborhoodCheckpoint.initNeighborhood(_solution);
-    for (int position = 0; position < n; position++) {
+    insertionWindow.candidates(_solution, insertPosition, positions);
+    int bestPosition = insertPosition;
+    for (const int position : positions) {
       if (insertPosition == position)
         continue;
       neighbor.set(insertPosition, position, n);
@@ -107,14 +118,18 @@ class BestInsertionExplorer
       if (bestNeighbor.invalid() ||
           neighborComparator(bestNeighbor, neighbor)) {
         bestNeighbor = neighbor;
+        bestPosition = position;
       }
       neighborhoodCheckpoint.neighborCall(neighbor);
     }
-    if (solNeighborComparator(_solution, bestNeighbor)) {
+    const bool improved = !bestNeighbor.invalid() &&
+                          solNeighborComparator(_solution, bestNeighbor);
+    if (improved) {
       bestNeighbor.move(_solution);
       _solution.fitness(bestNeighbor.fitness());
       improve = true;
     }
+    insertionWindow.feedback(std::abs(bestPosition - insertPosition), improved);
     neighborhoodCheckpoint.lastCall(_solution);
   }
 
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/global.hpp"
+#include "flowshop-solver/heuristics/neighborhood_checkpoint.hpp"
+#include "flowshop-solver/problems/FSP.hpp"
+#include "flowshop-solver/problems/FSPData.hpp"
+#include "flowshop-solver/problems/PermFSPEval.hpp"
+
+/**
+ * Insertion explorer restricted to the critical path of permutation flowshop
+ * makespan problems. Only jobs that belong to a critical block of two or more
+ * jobs are moved, and each one is tried at the first and at the last position
+ * of its own block, reordering the block around it.
+ *
+ * Each call evaluates the block boundaries of one critical job (in random
+ * order) and applies the best move if it improves. The critical path is
+ * recomputed after every improvement and a local optimum is reached when no
+ * critical job improves.
+ */
+template <class EOT>
+class CriticalBlockExplorer
+    : public moNeighborhoodExplorer<myShiftNeighbor<EOT>> {
+  using Ngh = myShiftNeighbor<EOT>;
+
+  PermFSPCompiler compiler;
+  moEval<Ngh>& neighborEval;
+  NeigborhoodCheckpoint<Ngh>& neighborhoodCheckpoint;
+  moNeighborComparator<Ngh>& neighborComparator;
+  moSolNeighborComparator<Ngh>& solNeighborComparator;
+
+  bool improve;
+  bool LO;
+  unsigned k;
+  std::vector<int> ct;
+  std::vector<CriticalBlock> blocks;
+  // (position, block index) of every movable critical job
+  std::vector<std::pair<int, int>> criticalJobs;
+
+  void findCriticalJobs(const EOT& sol) {
+    compiler.compile(sol, ct);
+    compiler.criticalBlocks(sol, blocks);
+    criticalJobs.clear();
+    for (int b = 0; b < static_cast<int>(blocks.size()); b++) {
+      if (blocks[b].first == blocks[b].last)
+        continue;
+      for (int i = blocks[b].first; i <= blocks[b].last; i++)
+        criticalJobs.emplace_back(i, b);
+    }
+    std::shuffle(criticalJobs.begin(), criticalJobs.end(),
+                 ParadiseoRNGFunctor<unsigned int>());
+    k = 0;
+  }
+
+ public:
+  CriticalBlockExplorer(const FSPData& fspData,
+                        moEval<Ngh>& neighborEval,
+                        NeigborhoodCheckpoint<Ngh>& neighborhoodCheckpoint,
+                        moNeighborComparator<Ngh>& neighborComparator,
+                        moSolNeighborComparator<Ngh>& solNeighborComparator)
+      : moNeighborhoodExplorer<Ngh>{},
+        compiler{fspData},
+        neighborEval{neighborEval},
+        neighborhoodCheckpoint{neighborhoodCheckpoint},
+        neighborComparator{neighborComparator},
+        solNeighborComparator{solNeighborComparator} {}
+
+  void initParam(EOT& _solution) final {
+    improve = false;
+    findCriticalJobs(_solution);
+    LO = criticalJobs.empty();
+  }
+
+  void updateParam(EOT& _solution) final {
+    if (improve) {
+      improve = false;
+      findCriticalJobs(_solution);
+      LO = criticalJobs.empty();
+    } else if (++k >= criticalJobs.size()) {
+      LO = true;
+    }
+  }
+
+  void operator()(EOT& _solution) final {
+    if (LO)
+      return;
+    const int n = static_cast<int>(_solution.size());
+    const int position = criticalJobs[k].first;
+    const CriticalBlock& block = blocks[criticalJobs[k].second];
+
+    Ngh neighbor, bestNeighbor;
+    neighborhoodCheckpoint.initNeighborhood(_solution);
+    for (const int target : {block.first, block.last}) {
+      if (target == position)
+        continue;
+      neighbor.set(position, target, n);
+      neighbor.invalidate();
+      neighborEval(_solution, neighbor);
+      if (bestNeighbor.invalid() ||
+          neighborComparator(bestNeighbor, neighbor)) {
+        bestNeighbor = neighbor;
+      }
+      neighborhoodCheckpoint.neighborCall(neighbor);
+    }
+    if (!bestNeighbor.invalid() &&
+        solNeighborComparator(_solution, bestNeighbor)) {
+      bestNeighbor.move(_solution);
+      _solution.fitness(bestNeighbor.fitness());
+      improve = true;
+    }
+    neighborhoodCheckpoint.lastCall(_solution);
+  }
+
+  auto isContinue(EOT&) -> bool final { return !LO; }
+  void move(EOT&) final {}
+  auto accept(EOT&) -> bool final { return true; }
+  void terminate(EOT&) final {}
+};
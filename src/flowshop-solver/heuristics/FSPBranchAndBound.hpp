@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "flowshop-solver/ThreadPool.hpp"
+#include "flowshop-solver/problems/FSPData.hpp"
+
+/** Optimum found by FSPBranchAndBound. */
+struct BranchAndBoundResult {
+  long optimum = std::numeric_limits<long>::max();
+  std::vector<int> solution;
+  unsigned long noNodes = 0;
+};
+
+/**
+ * Exact solver of the permutation flowshop (PERM type) for makespan or
+ * flowtime. A depth-first search appends one job at a time to a prefix,
+ * keeping the completion times of each prefix on every machine, so a node
+ * costs O(m) plus its lower bound.
+ *
+ * Lower bounds are machine based: for each machine, the remaining jobs are
+ * processed after the prefix, one at a time, and the last one still has to
+ * go through the following machines. For flowtime, the k-th remaining job on
+ * a machine completes after the k shortest remaining processing times. The
+ * children of a node are visited in increasing order of their bound.
+ *
+ * With more than one thread, the subtrees under the first two positions are
+ * searched concurrently and share the incumbent.
+ */
+class FSPBranchAndBound {
+ public:
+  using Callback = std::function<void(const std::vector<int>&, long)>;
+
+  FSPBranchAndBound(const FSPData& data, const std::string& objective)
+      : N{data.noJobs()},
+        M{data.noMachines()},
+        p(data.procTimesRef()),
+        tail(static_cast<std::size_t>(N) * M, 0),
+        sortedByTime(static_cast<std::size_t>(N) * M) {
+    if (objective != "MAKESPAN" && objective != "FLOWTIME")
+      throw std::runtime_error("No branch and bound for objective " +
+                               objective);
+    flowtime = objective == "FLOWTIME";
+    for (int m = M - 2; m >= 0; m--)
+      for (int j = 0; j < N; j++)
+        tail[m * N + j] = tail[(m + 1) * N + j] + p[(m + 1) * N + j];
+    for (int m = 0; m < M; m++) {
+      auto first = sortedByTime.begin() + m * N;
+      std::iota(first, first + N, 0);
+      std::stable_sort(first, first + N, [&](int a, int b) {
+        return p[m * N + a] < p[m * N + b];
+      });
+    }
+  }
+
+  /**
+   * Finds an optimal permutation. An initial solution (e.g. from NEH) gives
+   * the first upper bound.
+   */
+  auto solve(unsigned noThreads = 1, const std::vector<int>& initial = {})
+      -> BranchAndBoundResult {
+    BranchAndBoundResult result;
+    if (!initial.empty()) {
+      result.optimum = evaluate(initial);
+      result.solution = initial;
+    }
+    std::atomic<long> incumbent{result.optimum};
+    std::mutex mutex;
+    search(noThreads, result.noNodes, [&](Search& s, const Node& node) {
+      if (node.bound >= incumbent.load(std::memory_order_relaxed))
+        return false;
+      if (s.depth + 1 < N)
+        return true;
+      std::lock_guard<std::mutex> lock(mutex);
+      if (node.bound < result.optimum) {
+        result.optimum = node.bound;
+        result.solution = s.prefix;
+        result.solution.back() = node.job;
+        incumbent.store(node.bound, std::memory_order_relaxed);
+      }
+      return false;
+    });
+    return result;
+  }
+
+  /**
+   * Calls onSolution for every permutation with objective value at most
+   * `threshold`, in no particular order when threaded. Returns the number of
+   * nodes visited.
+   */
+  auto enumerate(long threshold,
+                 const Callback& onSolution,
+                 unsigned noThreads = 1) -> unsigned long {
+    unsigned long noNodes = 0;
+    std::mutex mutex;
+    search(noThreads, noNodes, [&](Search& s, const Node& node) {
+      if (node.bound > threshold)
+        return false;
+      if (s.depth + 1 < N)
+        return true;
+      std::lock_guard<std::mutex> lock(mutex);
+      s.prefix.back() = node.job;
+      onSolution(s.prefix, node.bound);
+      return false;
+    });
+    return noNodes;
+  }
+
+  /**
+   * Finds the optimum and then streams every permutation within `tolerance`
+   * of it to onSolution.
+   */
+  auto solve(long tolerance,
+             const Callback& onSolution,
+             unsigned noThreads = 1,
+             const std::vector<int>& initial = {}) -> BranchAndBoundResult {
+    auto result = solve(noThreads, initial);
+    result.noNodes += enumerate(result.optimum + tolerance, onSolution, noThreads);
+    return result;
+  }
+
+  /** Objective value of a complete permutation. */
+  [[nodiscard]] auto evaluate(const std::vector<int>& sol) const -> long {
+    std::vector<long> ct(M, 0);
+    long total = 0;
+    for (int job : sol) {
+      long prev = 0;
+      for (int m = 0; m < M; m++) {
+        ct[m] = std::max(ct[m], prev) + p[m * N + job];
+        prev = ct[m];
+      }
+      total += ct[M - 1];
+    }
+    return flowtime ? total : ct[M - 1];
+  }
+
+ private:
+  int N;
+  int M;
+  bool flowtime = false;
+  const std::vector<int>& p;
+  // processing time of a job on the machines after m
+  std::vector<long> tail;
+  // jobs in increasing order of processing time on each machine
+  std::vector<int> sortedByTime;
+
+  struct Node {
+    int job;
+    long bound;
+  };
+
+  /** State of one depth-first search. */
+  struct Search {
+    int depth = 0;
+    std::vector<int> prefix;
+    std::vector<char> scheduled;
+    // completion times of the prefix of each depth on each machine
+    std::vector<long> ct;
+    std::vector<long> flow;
+    // total processing time of the unscheduled jobs on each machine
+    std::vector<long> remaining;
+    std::vector<std::vector<Node>> children;
+  };
+
+  auto newSearch() const -> Search {
+    Search s;
+    s.prefix.assign(N, -1);
+    s.scheduled.assign(N, 0);
+    s.ct.assign(static_cast<std::size_t>(N + 1) * M, 0);
+    s.flow.assign(N + 1, 0);
+    s.remaining.assign(M, 0);
+    for (int m = 0; m < M; m++)
+      for (int j = 0; j < N; j++)
+        s.remaining[m] += p[m * N + j];
+    s.children.resize(N);
+    return s;
+  }
+
+  /** Completion times of prefix + job at depth + 1. */
+  void append(Search& s, int job) const {
+    const long* prev = s.ct.data() + s.depth * M;
+    long* next = s.ct.data() + (s.depth + 1) * M;
+    next[0] = prev[0] + p[job];
+    for (int m = 1; m < M; m++)
+      next[m] = std::max(next[m - 1], prev[m]) + p[m * N + job];
+    s.flow[s.depth + 1] = s.flow[s.depth] + next[M - 1];
+  }
+
+  /** Lower bound of the prefix at depth + 1, whose last job is `job`. */
+  auto bound(const Search& s, int job) const -> long {
+    const long* ct = s.ct.data() + (s.depth + 1) * M;
+    const int noRemaining = N - s.depth - 1;
+    if (noRemaining == 0)
+      return flowtime ? s.flow[s.depth + 1] : ct[M - 1];
+    long best = 0;
+    for (int m = 0; m < M; m++) {
+      long minTail = std::numeric_limits<long>::max();
+      for (int j = 0; j < N; j++)
+        if (!s.scheduled[j] && j != job)
+          minTail = std::min(minTail, tail[m * N + j]);
+      long lb = 0;
+      if (flowtime) {
+        long completion = ct[m];
+        lb = s.flow[s.depth + 1];
+        for (int k = 0; k < N; k++) {
+          const int j = sortedByTime[m * N + k];
+          if (s.scheduled[j] || j == job)
+            continue;
+          completion += p[m * N + j];
+          lb += completion;
+        }
+        lb += noRemaining * minTail;
+      } else {
+        lb = ct[m] + s.remaining[m] - p[m * N + job] + minTail;
+      }
+      best = std::max(best, lb);
+    }
+    return best;
+  }
+
+  /** Children of the prefix at the current depth, sorted by bound. */
+  void expand(Search& s) const {
+    auto& children = s.children[s.depth];
+    children.clear();
+    for (int j = 0; j < N; j++) {
+      if (s.scheduled[j])
+        continue;
+      append(s, j);
+      children.push_back({j, bound(s, j)});
+    }
+    std::stable_sort(children.begin(), children.end(),
+                     [](const Node& a, const Node& b) {
+                       return a.bound < b.bound;
+                     });
+  }
+
+  void push(Search& s, int job) const {
+    append(s, job);
+    s.prefix[s.depth] = job;
+    s.scheduled[job] = 1;
+    for (int m = 0; m < M; m++)
+      s.remaining[m] -= p[m * N + job];
+    s.depth++;
+  }
+
+  void pop(Search& s) const {
+    s.depth--;
+    const int job = s.prefix[s.depth];
+    s.scheduled[job] = 0;
+    for (int m = 0; m < M; m++)
+      s.remaining[m] += p[m * N + job];
+  }
+
+  /**
+   * Depth-first search below the current prefix. visit(s, child) decides
+   * whether to descend into a child, and handles complete permutations.
+   */
+  template <class Visit>
+  void dfs(Search& s, unsigned long& noNodes, Visit& visit) const {
+    expand(s);
+    for (const Node& node : s.children[s.depth]) {
+      noNodes++;
+      if (!visit(s, node))
+        continue;
+      push(s, node.job);
+      dfs(s, noNodes, visit);
+      pop(s);
+    }
+  }
+
+  template <class Visit>
+  void search(unsigned noThreads, unsigned long& noNodes, Visit visit) const {
+    if (N == 0)
+      return;
+    const int splitDepth = std::min(N - 1, 2);
+    if (noThreads <= 1 || splitDepth == 0) {
+      Search s = newSearch();
+      dfs(s, noNodes, visit);
+      return;
+    }
+    std::vector<std::vector<int>> prefixes;
+    for (int a = 0; a < N; a++)
+      for (int b = 0; b < N; b++)
+        if (a != b)
+          prefixes.push_back({a, b});
+    if (splitDepth == 1)
+      prefixes = {{0}, {1}};
+    // first-level nodes are shared by the tasks of their prefixes, so each
+    // is counted once here and tasks only count their last prefix node
+    std::atomic<unsigned long> totalNodes{splitDepth == 2 ? N : 0ul};
+    ThreadPool pool(noThreads);
+    pool.parallelFor(prefixes.size(), [&](unsigned i) {
+      Search s = newSearch();
+      unsigned long subtreeNodes = 0;
+      for (int job : prefixes[i]) {
+        append(s, job);
+        if (s.depth + 1 == splitDepth)
+          subtreeNodes++;
+        const Node node{job, bound(s, job)};
+        if (!visit(s, node)) {
+          totalNodes += subtreeNodes;
+          return;
+        }
+        push(s, job);
+      }
+      dfs(s, subtreeNodes, visit);
+      totalNodes += subtreeNodes;
+    });
+    noNodes += totalNodes;
+  }
+};
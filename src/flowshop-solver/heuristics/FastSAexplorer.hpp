@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/global.hpp"
+
+/**
+ * Memoized temperatures of a cooling schedule, indexed by iteration. Only
+ * schedules whose temperature depends on the iteration alone can be cached
+ * (moSimpleCoolingSchedule, opCoolingSchedule), not moDynSpanCoolingSchedule.
+ *
+ * The first `maxSize` temperatures are stored, so restarts of the search (e.g.
+ * in ISA) read them without calling the schedule again. Later iterations are
+ * computed on the fly.
+ */
+template <class EOT>
+class TemperatureTable {
+  moCoolingSchedule<EOT>& cooling;
+  const std::size_t maxSize;
+  std::vector<double> temperatures;
+  EOT first;
+  bool initialized = false;
+  // temperature of the schedule at iteration `cursor`
+  double liveTemperature = 0.0;
+  unsigned long cursor = 0;
+  // first iteration where the schedule stops, once known
+  bool finished = false;
+  unsigned long lastIteration = 0;
+
+  void restart() {
+    liveTemperature = cooling.init(first);
+    cursor = 0;
+  }
+
+  void step() {
+    cooling.update(liveTemperature, false);
+    cursor++;
+    if (!cooling(liveTemperature)) {
+      finished = true;
+      lastIteration = cursor;
+    } else if (cursor == temperatures.size() &&
+               temperatures.size() < maxSize) {
+      temperatures.push_back(liveTemperature);
+    }
+  }
+
+ public:
+  explicit TemperatureTable(moCoolingSchedule<EOT>& cooling,
+                            std::size_t maxSize = 1 << 20)
+      : cooling{cooling}, maxSize{maxSize} {}
+
+  void init(EOT& sol) {
+    if (initialized)
+      return;
+    initialized = true;
+    first = sol;
+    restart();
+    if (cooling(liveTemperature)) {
+      temperatures.push_back(liveTemperature);
+    } else {
+      finished = true;
+      lastIteration = 0;
+    }
+  }
+
+  /** Whether the schedule is still running at iteration k. */
+  auto isContinue(unsigned long k) -> bool {
+    if (k < temperatures.size())
+      return true;
+    if (finished && k >= lastIteration)
+      return false;
+    if (k < cursor)
+      restart();
+    while (cursor < k) {
+      step();
+      if (finished && cursor == lastIteration)
+        return false;
+    }
+    return true;
+  }
+
+  /** Temperature at iteration k, isContinue(k) must be true. */
+  auto operator[](unsigned long k) const -> double {
+    return k < temperatures.size() ? temperatures[k] : liveTemperature;
+  }
+
+  [[nodiscard]] auto cachedSize() const -> std::size_t {
+    return temperatures.size();
+  }
+};
+
+/**
+ * Simulated annealing explorer reading temperatures from a TemperatureTable.
+ *
+ * Moves are accepted as in moSAexplorer, with probability exp(-|delta| / T).
+ * One uniform number u is drawn per move, and the move is accepted when
+ * |delta| < -T ln(u). The bounds 1 - x <= exp(-x) <= 1 / (1 + x) decide most
+ * moves without calling exp. It is only evaluated when u falls between them,
+ * which rarely happens at low temperatures.
+ *
+ * Each call evaluates up to `batchSize` random neighbors of the current
+ * solution and stops at the first accepted one. Rejected neighbors leave the
+ * solution unchanged, so this is the same chain as one neighbor per
+ * iteration. The checkpoint is just called once per batch, but the batch stops
+ * as soon as `budget` (e.g. the evaluation budget of the problem) is over.
+ */
+template <class Ngh>
+class FastSAexplorer : public moNeighborhoodExplorer<Ngh> {
+ public:
+  using EOT = typename Ngh::EOT;
+  using moNeighborhoodExplorer<Ngh>::neighborhood;
+  using moNeighborhoodExplorer<Ngh>::eval;
+  using moNeighborhoodExplorer<Ngh>::currentNeighbor;
+  using moNeighborhoodExplorer<Ngh>::selectedNeighbor;
+
+  FastSAexplorer(moNeighborhood<Ngh>& neighborhood,
+                 moEval<Ngh>& eval,
+                 moSolNeighborComparator<Ngh>& solNeighborComparator,
+                 TemperatureTable<EOT>& temperatures,
+                 unsigned batchSize = 1,
+                 moContinuator<Ngh>* budget = nullptr)
+      : moNeighborhoodExplorer<Ngh>(neighborhood, eval),
+        solNeighborComparator{solNeighborComparator},
+        temperatures{temperatures},
+        batchSize{std::max(batchSize, 1u)},
+        budget{budget} {}
+
+  void initParam(EOT& _solution) final {
+    temperatures.init(_solution);
+    iteration = 0;
+    isAccept = false;
+  }
+
+  void updateParam(EOT&) final { iteration++; }
+
+  void terminate(EOT&) final {}
+
+  void operator()(EOT& _solution) final {
+    isAccept = false;
+    if (!neighborhood.hasNeighbor(_solution))
+      return;
+    for (unsigned b = 0;; b++) {
+      neighborhood.init(_solution, currentNeighbor);
+      eval(_solution, currentNeighbor);
+      isAccept = acceptNeighbor(_solution, temperatures[iteration]);
+      if (isAccept)
+        selectedNeighbor = currentNeighbor;
+      if (isAccept || b + 1 == batchSize ||
+          !temperatures.isContinue(iteration + 1) ||
+          (budget != nullptr && !(*budget)(_solution)))
+        return;
+      // rejected moves only advance the schedule
+      iteration++;
+    }
+  }
+
+  auto isContinue(EOT&) -> bool final {
+    return temperatures.isContinue(iteration);
+  }
+
+  auto accept(EOT&) -> bool final { return isAccept; }
+
+  void move(EOT& _solution) final {
+    selectedNeighbor.move(_solution);
+    _solution.fitness(selectedNeighbor.fitness());
+  }
+
+ private:
+  moSolNeighborComparator<Ngh>& solNeighborComparator;
+  TemperatureTable<EOT>& temperatures;
+  const unsigned batchSize;
+  moContinuator<Ngh>* budget;
+  unsigned long iteration = 0;
+  bool isAccept = false;
+
+  auto acceptNeighbor(EOT& _solution, double temperature) -> bool {
+    if (solNeighborComparator(_solution, currentNeighbor))
+      return true;
+    const double delta =
+        std::abs(static_cast<double>(currentNeighbor.fitness()) -
+                 static_cast<double>(_solution.fitness()));
+    const double x = delta / temperature;
+    const double u = RNG::paradiseo().uniform();
+    if (u < 1.0 - x)
+      return true;
+    if (u * (1.0 + x) >= 1.0)
+      return false;
+    return u < std::exp(-x);
+  }
+};
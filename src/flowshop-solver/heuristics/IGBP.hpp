@@ -2,8 +2,10 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <iostream>
-
+#include <memory>
+#include <stdexcept>
 #include <string>
 
 #include "flowshop-solver/heuristics.hpp"
@@ -13,15 +15,133 @@
 #include "flowshop-solver/FSPProblemFactory.hpp"
 #include "flowshop-solver/global.hpp"
 #include "flowshop-solver/MHParamsSpecsFactory.hpp"
+#include "flowshop-solver/ThreadPool.hpp"
+#include "flowshop-solver/problems/FSPProblemCopies.hpp"
+
+/**
+ * Perturbation and local search branches of IGBP, one per destruction size.
+ *
+ * With a single thread every branch shares the operators of the main problem
+ * and runs sequentially. With more threads each branch owns a copy of the
+ * problem (evaluators, counters and checkpoints), operators built on it and a
+ * random stream, and the branches run on a thread pool. Sequential reduction
+ * steps run in branch order, so results only depend on the seed and the
+ * number of threads. Evaluations of the branches are added to the main
+ * problem counters after every parallel step.
+ *
+ * With a positive sharedAOSPeriod, the operator selections of the threaded
+ * branches share their rewards every sharedAOSPeriod feedbacks. Results then
+ * also depend on thread timing.
+ *
+ * Threaded branches are traced and persisted like the operator selections of
+ * the main factory, and the fitness of their checkpoints is forwarded to the
+ * AOS trace. Other statistics of the main checkpoints do not see them.
+ */
+class IGBPBranches {
+  using Ngh = FSPNeighbor;
+
+  FSPProblemCopies problems;
+  std::vector<std::unique_ptr<eoFSPFactory>> factories;
+  std::vector<std::unique_ptr<RNG::Stream>> streams;
+  std::unique_ptr<SharedOperatorRewardsRegistry> sharedRewards;
+  std::unique_ptr<AOSTraceFitness<FSP>> traceFitness;
+  std::unique_ptr<ThreadPool> pool;
+
+ public:
+  std::vector<moPerturbation<Ngh>*> perturbs;
+  std::vector<moLocalSearch<Ngh>*> localSearches;
+
+  IGBPBranches(FSPProblem& problem,
+               eoFSPFactory& factory,
+               MHParamsValues& params,
+               const std::vector<int>& destructionSizes,
+               moLocalSearch<Ngh>* localSearch,
+               unsigned noThreads,
+               int sharedAOSPeriod = 0)
+      : problems{problem,
+                 noThreads > 1 ? static_cast<unsigned>(destructionSizes.size())
+                               : 0u} {
+    const unsigned noOps = destructionSizes.size();
+    noThreads = std::min(noThreads, noOps);
+    if (noThreads > 1 && sharedAOSPeriod > 0)
+      sharedRewards = std::make_unique<SharedOperatorRewardsRegistry>(noOps);
+    if (noThreads > 1 && factory.operatorSelectionTrace() != nullptr)
+      traceFitness = std::make_unique<AOSTraceFitness<FSP>>(
+          *factory.operatorSelectionTrace());
+    for (unsigned i = 0; i < noOps; i++) {
+      params["IGBP.Perturb.DestructionSize"] = destructionSizes[i];
+      if (noThreads <= 1) {
+        perturbs.push_back(factory.buildPerturb());
+        localSearches.push_back(localSearch);
+      } else {
+        factories.push_back(std::make_unique<eoFSPFactory>(params, problems[i]));
+        factory.forwardOperatorSelection(*factories.back());
+        if (traceFitness)
+          problems[i].checkpoint().add(*traceFitness);
+        if (sharedRewards)
+          factories.back()->shareOperatorSelection(*sharedRewards,
+                                                   sharedAOSPeriod);
+        streams.push_back(std::make_unique<RNG::Stream>(RNG::engine()));
+        perturbs.push_back(factories.back()->buildPerturb());
+        localSearches.push_back(factories.back()->buildLocalSearch());
+      }
+    }
+    if (noThreads > 1)
+      pool = std::make_unique<ThreadPool>(noThreads);
+  }
 
-template <class PertT, class LOT, class AccT, class EOT>
-void globalGlobalReward(bool                      firstIteration,
-                        const std::vector<PertT*> perturbs,
-                        LOT*                      localSearch,
-                        AccT*                     accept,
-                        EOT&                      sol) {
+  [[nodiscard]] auto size() const -> unsigned { return perturbs.size(); }
+
+  /**
+   * Calls work(i) for every branch, concurrently when there is a thread
+   * pool, and then reduce(i) in branch order.
+   */
+  template <class Work, class Reduce>
+  void run(Work work, Reduce reduce) {
+    if (!pool) {
+      for (unsigned i = 0; i < size(); i++) {
+        work(i);
+        reduce(i);
+      }
+      return;
+    }
+    problems.sync();
+    pool->parallelFor(size(), [&](unsigned i) {
+      RNG::StreamGuard guard{*streams[i]};
+      work(i);
+    });
+    problems.merge();
+    for (unsigned i = 0; i < size(); i++)
+      reduce(i);
+  }
+
+  template <class Work>
+  void run(Work work) {
+    run(work, [](unsigned) {});
+  }
+};
+
+/**
+ * ParadisEO random neighborhoods and moRandomBestHC draw from the global
+ * generator, so they cannot run in concurrent branches.
+ */
+inline auto igbpBranchesUseGlobalRNG(const eoFSPFactory& factory) -> bool {
+  const auto perturb = factory.categoricalName(".Perturb");
+  return factory.localSearchUsesGlobalRNG(
+             factory.categoricalName(".Local.Search")) ||
+         ((perturb == "lsps" || perturb == "adaptive") &&
+          factory.localSearchUsesGlobalRNG(
+              factory.categoricalName(".LSPS.Local.Search", "none")));
+}
+
+template <class AccT, class EOT>
+void globalGlobalReward(bool           firstIteration,
+                        IGBPBranches&  branches,
+                        AccT*          accept,
+                        EOT&           sol) {
   FSPNeighbor emptyNeighbor;
-  const auto  noOps = perturbs.size();
+  const auto  noOps = branches.size();
+  const auto& perturbs = branches.perturbs;
 
   FSP currentSol = sol;
   // currentSol.fitness(sol.fitness());
@@ -29,37 +149,34 @@ void globalGlobalReward(bool                      firstIteration,
   std::vector<FSP> solsP(noOps, sol);
 
   if (!firstIteration) {
-    for (unsigned i = 0; i < noOps; i++)
-      (*perturbs[i])(solsP[i]);
+    branches.run([&](unsigned i) { (*perturbs[i])(solsP[i]); });
   }
 
   // apply the local search on the copy
-  for (unsigned i = 0; i < noOps; i++) {
-    (*localSearch)(solsP[i]);
-
-    // if a solution in the neighborhood can be accepted
-    if ((*accept)(sol, solsP[i])) {
-      for (auto& perturb : perturbs)
-        perturb->add(sol, emptyNeighbor);
-      accept->add(sol, emptyNeighbor);
-    } else {
-      solsP[i] = currentSol;
-    }
-
-  }
+  branches.run([&](unsigned i) { (*branches.localSearches[i])(solsP[i]); },
+               [&](unsigned i) {
+                 // if a solution in the neighborhood can be accepted
+                 if ((*accept)(sol, solsP[i])) {
+                   for (auto& perturb : perturbs)
+                     perturb->add(sol, emptyNeighbor);
+                   accept->add(sol, emptyNeighbor);
+                 } else {
+                   solsP[i] = currentSol;
+                 }
+               });
   sol = *std::min_element(begin(solsP), end(solsP), [&](FSP& a, FSP& b) {
     return a.fitness() > b.fitness();
   });
 }
 
-template <class PertT, class LOT, class AccT, class EOT>
-void globalLocalReward(bool                      firstIteration,
-                       const std::vector<PertT*> perturbs,
-                       LOT*                      localSearch,
-                       AccT*                     accept,
-                       EOT&                      sol) {
+template <class AccT, class EOT>
+void globalLocalReward(bool           firstIteration,
+                       IGBPBranches&  branches,
+                       AccT*          accept,
+                       EOT&           sol) {
   FSPNeighbor emptyNeighbor;
-  const auto  noOps = perturbs.size();
+  const auto  noOps = branches.size();
+  const auto& perturbs = branches.perturbs;
 
   FSP currentSol = sol;
   // currentSol.fitness(sol.fitness());
@@ -67,13 +184,11 @@ void globalLocalReward(bool                      firstIteration,
   std::vector<FSP> solsP(noOps, sol);
 
   if (!firstIteration) {
-    for (unsigned i = 0; i < noOps; i++)
-      (*perturbs[i])(solsP[i]);
+    branches.run([&](unsigned i) { (*perturbs[i])(solsP[i]); });
   }
 
   // apply the local search on the copy
-  for (auto& solP : solsP)
-    (*localSearch)(solP);
+  branches.run([&](unsigned i) { (*branches.localSearches[i])(solsP[i]); });
 
   currentSol = *std::min_element(begin(solsP), end(solsP), [&](FSP& a, FSP& b) {
     return a.fitness() > b.fitness();
@@ -88,14 +203,15 @@ void globalLocalReward(bool                      firstIteration,
   }
 }
 
-template <class PertT, class LOT, class AccT, class EOT>
-void localGlobalReward(bool                      firstIteration,
-                       const std::vector<PertT*> perturbs,
-                       LOT*                      localSearch,
-                       AccT*                     accept,
-                       EOT&                      sol) {
+template <class LOT, class AccT, class EOT>
+void localGlobalReward(bool           firstIteration,
+                       IGBPBranches&  branches,
+                       LOT*           localSearch,
+                       AccT*          accept,
+                       EOT&           sol) {
   FSPNeighbor emptyNeighbor;
-  const auto  noOps = perturbs.size();
+  const auto  noOps = branches.size();
+  const auto& perturbs = branches.perturbs;
 
   FSP currentSol = sol;
   // currentSol.fitness(sol.fitness());
@@ -105,25 +221,28 @@ void localGlobalReward(bool                      firstIteration,
   double bestReward = -std::numeric_limits<double>::infinity();
   if (!firstIteration) {
     FSP initialSolution = sol;
-    for (unsigned i = 0; i < noOps; i++) {
-      (*perturbs[i])(solsP[i]);
-      double initialFintess = solsP[i].fitness();
-      (*localSearch)(solsP[i]);
-
-      // if a solution in the neighborhood can be accepted
-      if ((*accept)(initialSolution, solsP[i])) {
-        for (auto& perturb : perturbs)
-          perturb->add(solsP[i], emptyNeighbor);
-        accept->add(solsP[i], emptyNeighbor);
-      } else {
-        solsP[i] = initialSolution;
-      }
-
-      if (initialFintess - solsP[i].fitness() > bestReward) {
-        sol = solsP[i];
-        bestReward = initialFintess - solsP[i].fitness();
-      }
-    }
+    std::vector<double> initialFitness(noOps);
+    branches.run(
+        [&](unsigned i) {
+          (*perturbs[i])(solsP[i]);
+          initialFitness[i] = solsP[i].fitness();
+          (*branches.localSearches[i])(solsP[i]);
+        },
+        [&](unsigned i) {
+          // if a solution in the neighborhood can be accepted
+          if ((*accept)(initialSolution, solsP[i])) {
+            for (auto& perturb : perturbs)
+              perturb->add(solsP[i], emptyNeighbor);
+            accept->add(solsP[i], emptyNeighbor);
+          } else {
+            solsP[i] = initialSolution;
+          }
+
+          if (initialFitness[i] - solsP[i].fitness() > bestReward) {
+            sol = solsP[i];
+            bestReward = initialFitness[i] - solsP[i].fitness();
+          }
+        });
   } else {
     (*localSearch)(currentSol);
     if ((*accept)(sol, currentSol)) {
@@ -135,14 +254,15 @@ void localGlobalReward(bool                      firstIteration,
   }
 }
 
-template <class PertT, class LOT, class AccT, class EOT>
-auto localLocalReward(bool                      firstIteration,
-                      const std::vector<PertT*> perturbs,
-                      LOT*                      localSearch,
-                      AccT*                     accept,
-                      EOT&                      sol) -> unsigned {
+template <class LOT, class AccT, class EOT>
+auto localLocalReward(bool           firstIteration,
+                      IGBPBranches&  branches,
+                      LOT*           localSearch,
+                      AccT*          accept,
+                      EOT&           sol) -> unsigned {
   FSPNeighbor emptyNeighbor;
-  const auto  noOps = perturbs.size();
+  const auto  noOps = branches.size();
+  const auto& perturbs = branches.perturbs;
 
   FSP currentSol = sol;
   // currentSol.fitness(sol.fitness());
@@ -152,16 +272,20 @@ auto localLocalReward(bool                      firstIteration,
   double bestReward = -std::numeric_limits<double>::infinity();
   unsigned bestPerturb = 0;
   if (!firstIteration) {
-    for (unsigned i = 0; i < noOps; i++) {
-      (*perturbs[i])(solsP[i]);
-      double initialFintess = solsP[i].fitness();
-      (*localSearch)(solsP[i]);
-      if (initialFintess - solsP[i].fitness() > bestReward) {
-        currentSol = solsP[i];
-        bestReward = initialFintess - solsP[i].fitness();
-        bestPerturb = i;
-      }
-    }
+    std::vector<double> initialFitness(noOps);
+    branches.run(
+        [&](unsigned i) {
+          (*perturbs[i])(solsP[i]);
+          initialFitness[i] = solsP[i].fitness();
+          (*branches.localSearches[i])(solsP[i]);
+        },
+        [&](unsigned i) {
+          if (initialFitness[i] - solsP[i].fitness() > bestReward) {
+            currentSol = solsP[i];
+            bestReward = initialFitness[i] - solsP[i].fitness();
+            bestPerturb = i;
+          }
+        });
   } else {
     (*localSearch)(currentSol);
   }
@@ -177,20 +301,24 @@ auto localLocalReward(bool                      firstIteration,
   return bestPerturb;
 }
 
-inline auto solveWithIGBP(FSPProblem& problem, MHParamsValues& paramsValues, const RunOptions& runOptions)
-    -> Result {
+/**
+ * `factory` must be built on `paramsValues`, whose destruction size is set for
+ * each branch. When it traces operator selections, every iteration also
+ * records the index of the chosen destruction size (the branch events of
+ * printDestructionChoices), the improvement and the fitness.
+ *
+ * Fitness rewards are computed from the main local checkpoint, which threaded
+ * branches do not drive, so printFitnessReward needs IGBP.Threads = 1.
+ */
+inline auto solveWithIGBP(FSPProblem& problem,
+                          eoFSPFactory& factory,
+                          MHParamsValues& paramsValues,
+                          const RunOptions& runOptions) -> Result {
 
   FSPNeighbor emptyNeighbor;
+  AOSTraceWriter* trace = factory.operatorSelectionTrace();
 
-  eoFSPFactory factory{paramsValues, problem};
-
-  const std::vector<int>                        destructionSizes = {2, 4, 8};
-  const unsigned                                noOps = destructionSizes.size();
-  std::vector<moPerturbation<FSPProblem::Ngh>*> perturbs(noOps, nullptr);
-  for (unsigned i = 0; i < noOps; i++) {
-    paramsValues["IGBP.Perturb.DestructionSize"] = destructionSizes[i];
-    perturbs[i]                                  = factory.buildPerturb();
-  }
+  const std::vector<int> destructionSizes = {2, 4, 8};
 
   FitnessRewards<FSP> rewards;
   /*RewardPrinter<FSP>  rewardPrinter{rewards};
@@ -212,6 +340,22 @@ inline auto solveWithIGBP(FSPProblem& problem, MHParamsValues& paramsValues, con
   auto algo   = factory.buildLocalSearch();
   auto accept = factory.buildAcceptanceCriterion();
 
+  const unsigned noThreads =
+      std::stoi(paramsValues.categoricalName("IGBP.Threads", "1"));
+  if (noThreads > 1 && igbpBranchesUseGlobalRNG(factory))
+    throw std::runtime_error(
+        "IGBP.Threads > 1 requires ordered neighborhoods and no "
+        "random_best_improvement or adaptive local search");
+  if (noThreads > 1 && runOptions.printFitnessReward)
+    throw std::runtime_error(
+        "IGBP.Threads > 1 does not report the fitness rewards of the branches");
+  const int sharedAOSPeriod =
+      std::stoi(paramsValues.categoricalName("IGBP.AOS.SharedPeriod", "0"));
+  IGBPBranches branches{problem,          factory,   paramsValues,
+                        destructionSizes, algo,      noThreads,
+                        sharedAOSPeriod};
+  auto& perturbs = branches.perturbs;
+
   FSP _solution;
   (*init)(_solution);
   problem.checkpoint().init(_solution);
@@ -237,19 +381,23 @@ inline auto solveWithIGBP(FSPProblem& problem, MHParamsValues& paramsValues, con
     // perturb solution exept at the first iteration
 
     unsigned best = 0;
+    const double previousFitness = _solution.fitness();
     if (paramsValues.categorical("IGBP.AOS.RewardType") == 0)
-      globalGlobalReward(firstIteration, perturbs, algo, accept, _solution);
+      globalGlobalReward(firstIteration, branches, accept, _solution);
     else if (paramsValues.categorical("IGBP.AOS.RewardType") == 1)
-      globalLocalReward(firstIteration, perturbs, algo, accept, _solution);
+      globalLocalReward(firstIteration, branches, accept, _solution);
     else if (paramsValues.categorical("IGBP.AOS.RewardType") == 2)
-      localGlobalReward(firstIteration, perturbs, algo, accept, _solution);
+      localGlobalReward(firstIteration, branches, algo, accept, _solution);
     else if (paramsValues.categorical("IGBP.AOS.RewardType") == 3)
-      best = localLocalReward(firstIteration, perturbs, algo, accept, _solution);
+      best = localLocalReward(firstIteration, branches, algo, accept, _solution);
 
     if (runOptions.printDestructionChoices && !firstIteration) {
       timer(_solution);
       std::cout << timer.value() << ' ' << destructionSizes[best] << '\n';
     }
+    if (trace != nullptr && !firstIteration)
+      trace->record(best, previousFitness - _solution.fitness(),
+                    _solution.fitness());
 
     if (firstIteration)
       firstIteration = false;
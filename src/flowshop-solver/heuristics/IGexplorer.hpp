@@ -10,10 +10,121 @@
 #include "flowshop-solver/problems/FSPEval.hpp"
 
 /**
- * Explorer for a simple Hill-climbing
+ * Explorer for the iterated greedy insertion local search (Ruiz and Stuetzle):
+ * each job is removed and reinserted in its best position, ties are broken
+ * uniformly at random. Insertions are evaluated with the neighbor evaluation
+ * (Taillard acceleration for permutation makespan), without copying the
+ * solution.
  */
 template <class Neighbor, class EOT = typename Neighbor::EOT>
 class IGexplorer : public moNeighborhoodExplorer<Neighbor> {
+  moEval<Neighbor>& neighborEval;
+  int size;
+  moSolComparator<EOT>& solComparator;
+  NeigborhoodCheckpoint<Neighbor> neighborhoodCheckpoint;
+  // true if the solution has changed
+  bool improve;
+  bool LO;
+  std::vector<int> RandJOB;
+  unsigned k;
+  // scratch storage reused between calls
+  Neighbor neighbor;
+  EOT best, candidate;
+  std::vector<int> ties;
+
+ public:
+  IGexplorer(moEval<Neighbor>& neighborEval,
+             int size,
+             moSolComparator<EOT>& _solComparator,
+             NeigborhoodCheckpoint<Neighbor> neighborhoodCheckpoint =
+                 NeigborhoodCheckpoint<Neighbor>())
+      : moNeighborhoodExplorer<Neighbor>(),
+        neighborEval(neighborEval),
+        size(size),
+        solComparator(_solComparator),
+        neighborhoodCheckpoint{std::move(neighborhoodCheckpoint)} {}
+
+  void initParam(EOT& _solution) override {
+    improve = false;
+    LO = false;
+    RandJOB.resize(size);
+    std::copy(_solution.begin(), _solution.end(), RandJOB.begin());
+    std::shuffle(RandJOB.begin(), RandJOB.end(),
+                 ParadiseoRNGFunctor<unsigned int>());
+    k = 0;
+    neighborhoodCheckpoint.init(_solution);
+  }
+
+  void updateParam(EOT&) override {
+    if (k < RandJOB.size() - 1)
+      k++;
+    else {
+      k = 0;
+      std::shuffle(RandJOB.begin(), RandJOB.end(),
+                   ParadiseoRNGFunctor<unsigned int>());
+    }
+    if (k == 0 && !improve) {
+      LO = true;
+    }
+    improve = false;
+  }
+
+  void terminate(EOT&) override {}
+
+  /**
+   * Explore the insertion positions of job RandJOB[k]
+   * @param _solution the current solution
+   */
+  void operator()(EOT& _solution) override {
+    neighborhoodCheckpoint.initNeighborhood(_solution);
+    const int n = static_cast<int>(_solution.size());
+    int j = 0;
+    while (_solution[j] != RandJOB[k]) {
+      j++;
+    }
+    ties.clear();
+    best.invalidate();
+    for (int position = 0; position < n; position++) {
+      if (position == j)
+        continue;
+      neighbor.set(j, position, n);
+      neighbor.invalidate();
+      neighborEval(_solution, neighbor);
+      candidate.fitness(neighbor.fitness());
+      if (best.invalid() || solComparator(best, candidate)) {
+        best.fitness(candidate.fitness());
+        ties.assign(1, position);
+      } else if (solComparator.equals(best, candidate)) {
+        ties.push_back(position);
+      }
+    }
+    if (ties.empty()) {
+      neighborhoodCheckpoint.lastNeighborhoodCall(_solution);
+      return;
+    }
+    const int chosen = RNG::intUniform(ties.size() - 1);
+    if (solComparator(_solution, best)) {
+      neighbor.set(j, ties[chosen], n);
+      neighbor.move(_solution);
+      _solution.fitness(best.fitness());
+      improve = true;
+    }
+    neighborhoodCheckpoint.lastNeighborhoodCall(_solution);
+  }
+
+  bool isContinue(EOT&) override { return !LO; }
+
+  void move(EOT&) override {}
+
+  bool accept(EOT&) override { return false; }
+};
+
+/**
+ * Reference implementation of IGexplorer that builds and fully evaluates a
+ * copy of the solution for every insertion position. Kept for benchmarking.
+ */
+template <class Neighbor, class EOT = typename Neighbor::EOT>
+class FullEvalIGexplorer : public moNeighborhoodExplorer<Neighbor> {
   eoEvalFunc<EOT>& eval;
   int size;
   moSolComparator<EOT>& solComparator;
@@ -26,7 +137,7 @@ class IGexplorer : public moNeighborhoodExplorer<Neighbor> {
   unsigned k;
 
  public:
-  IGexplorer(eoEvalFunc<EOT>& _fullEval,
+  FullEvalIGexplorer(eoEvalFunc<EOT>& _fullEval,
              int size,
              moSolComparator<EOT>& _solComparator,
              NeigborhoodCheckpoint<Neighbor> neighborhoodCheckpoint =
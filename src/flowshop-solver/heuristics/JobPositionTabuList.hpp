@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <paradiseo/mo/mo>
+
+/**
+ * Attribute based tabu list for shift moves. After a job is moved away from
+ * a position, placing it back at that position is tabu for `howLong`
+ * iterations. Tenures are kept in a job x position matrix, so check, add and
+ * expiration are O(1) regardless of the tenure.
+ *
+ * Neighbors must provide firstSecond(size) returning the position of the
+ * moved job before and after the move (see myShiftNeighbor).
+ */
+template <class Neighbor>
+class JobPositionTabuList : public moTabuList<Neighbor> {
+ public:
+  using EOT = typename Neighbor::EOT;
+
+  explicit JobPositionTabuList(unsigned howLong) : howLong{howLong} {}
+
+  void init(EOT& _sol) override {
+    noJobs = _sol.size();
+    tabuUntil.assign(noJobs * noJobs, 0);
+    iteration = 0;
+  }
+
+  /**
+   * @param _sol the solution after the move
+   * @param _neighbor the applied move
+   */
+  void add(EOT& _sol, Neighbor& _neighbor) override {
+    const auto fs = _neighbor.firstSecond(_sol.size());
+    const unsigned job = _sol[fs.second];
+    // update is called right after add, so the move stays tabu during the
+    // next howLong iterations
+    tabuUntil[job * noJobs + fs.first] = iteration + 1 + howLong;
+  }
+
+  void update(EOT&, Neighbor&) override { iteration++; }
+
+  auto check(EOT& _sol, Neighbor& _neighbor) -> bool override {
+    const auto fs = _neighbor.firstSecond(_sol.size());
+    const unsigned job = _sol[fs.first];
+    return tabuUntil[job * noJobs + fs.second] > iteration;
+  }
+
+  void clearMemory() override {
+    std::fill(tabuUntil.begin(), tabuUntil.end(), 0);
+  }
+
+ private:
+  const unsigned howLong;
+  unsigned noJobs = 0;
+  unsigned long iteration = 0;
+  // iteration until which placing job j at position p is tabu
+  std::vector<unsigned long> tabuUntil;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/** Buffers reused by the permutation crossovers of one worker. */
+struct CrossoverScratch {
+  std::vector<char> used;
+  std::vector<int> position;
+};
+
+/**
+ * Order crossover (OX). The child keeps p1[a..b] in place and fills the other
+ * positions, starting after b and wrapping around, with the remaining jobs in
+ * the order they appear in p2 starting after b.
+ */
+inline void orderCrossover(const int* p1,
+                           const int* p2,
+                           int* child,
+                           int n,
+                           int a,
+                           int b,
+                           CrossoverScratch& scratch) {
+  auto& used = scratch.used;
+  used.assign(n, 0);
+  for (int i = a; i <= b; i++) {
+    child[i] = p1[i];
+    used[p1[i]] = 1;
+  }
+  int write = (b + 1) % n;
+  for (int k = 1; k <= n; k++) {
+    const int job = p2[(b + k) % n];
+    if (used[job])
+      continue;
+    child[write] = job;
+    write = (write + 1) % n;
+  }
+}
+
+/**
+ * Partially mapped crossover (PMX). The child keeps p1[a..b] in place and
+ * takes the other positions from p2, following the mapping p1[i] -> p2[i] of
+ * the segment until a job outside of it is found.
+ */
+inline void partiallyMappedCrossover(const int* p1,
+                                     const int* p2,
+                                     int* child,
+                                     int n,
+                                     int a,
+                                     int b,
+                                     CrossoverScratch& scratch) {
+  auto& position = scratch.position;
+  position.resize(n);
+  for (int i = 0; i < n; i++)
+    position[p1[i]] = i;
+  const auto inSegment = [&](int job) {
+    return position[job] >= a && position[job] <= b;
+  };
+  for (int i = 0; i < n; i++) {
+    if (i >= a && i <= b) {
+      child[i] = p1[i];
+      continue;
+    }
+    int job = p2[i];
+    while (inSegment(job))
+      job = p2[position[job]];
+    child[i] = job;
+  }
+}
+
+using PermutationCrossover = void (*)(const int*,
+                                      const int*,
+                                      int*,
+                                      int,
+                                      int,
+                                      int,
+                                      CrossoverScratch&);
+
+inline auto permutationCrossover(const std::string& name)
+    -> PermutationCrossover {
+  if (name == "ox")
+    return orderCrossover;
+  if (name == "pmx")
+    return partiallyMappedCrossover;
+  return nullptr;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Population of permutations of n jobs stored row by row in one contiguous
+ * buffer, with their (minimized) fitness values.
+ */
+class PopulationArena {
+  int n;
+  std::vector<int> jobs;
+  std::vector<double> fitnesses;
+
+ public:
+  PopulationArena(int size, int n)
+      : n{n}, jobs(static_cast<std::size_t>(size) * n), fitnesses(size) {}
+
+  [[nodiscard]] auto size() const -> int {
+    return static_cast<int>(fitnesses.size());
+  }
+
+  [[nodiscard]] auto noJobs() const -> int { return n; }
+
+  auto operator[](int i) -> int* { return jobs.data() + i * n; }
+  auto operator[](int i) const -> const int* { return jobs.data() + i * n; }
+
+  [[nodiscard]] auto fitness(int i) const -> double { return fitnesses[i]; }
+
+  template <class EOT>
+  void store(int i, const EOT& sol) {
+    std::copy(sol.begin(), sol.end(), (*this)[i]);
+    fitnesses[i] = sol.fitness();
+  }
+
+  template <class EOT>
+  void load(int i, EOT& sol) const {
+    sol.assign((*this)[i], (*this)[i] + n);
+    sol.fitness(fitnesses[i]);
+  }
+
+  [[nodiscard]] auto best() const -> int {
+    return static_cast<int>(
+        std::distance(fitnesses.begin(),
+                      std::min_element(fitnesses.begin(), fitnesses.end())));
+  }
+
+  [[nodiscard]] auto worst() const -> int {
+    return static_cast<int>(
+        std::distance(fitnesses.begin(),
+                      std::max_element(fitnesses.begin(), fitnesses.end())));
+  }
+
+  /** Whether an individual with the same fitness and jobs exists. */
+  template <class EOT>
+  [[nodiscard]] auto contains(const EOT& sol) const -> bool {
+    const double fitness = sol.fitness();
+    for (int i = 0; i < size(); i++) {
+      if (fitnesses[i] == fitness &&
+          std::equal(sol.begin(), sol.end(), (*this)[i]))
+        return true;
+    }
+    return false;
+  }
+};
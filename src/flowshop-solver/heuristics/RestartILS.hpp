@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+/**
+ * Iterated local search with random restarts that reuses the local search
+ * across restarts. Same search as moILS with moRestartPerturb and
+ * moAlwaysAcceptCrit (except that the initial solution is also improved), but
+ * the explorer and the local checkpoint are driven directly: a restart only
+ * draws a new solution, evaluates it and initializes the local checkpoint and
+ * the explorer parameters. The global checkpoint is initialized once per run.
+ *
+ * Time spent restarting (setup) and running the local search (search) is
+ * accumulated separately.
+ */
+template <class Ngh>
+class RestartILS : public moLocalSearch<Ngh> {
+ public:
+  using EOT = typename Ngh::EOT;
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @param localSearch the local search run after every restart, its explorer
+   * and continuator are driven directly
+   * @param init the restart operator
+   * @param fullEval the full evaluation function
+   * @param checkpointGlobal the continuator of the whole search
+   */
+  RestartILS(moLocalSearch<Ngh>& localSearch,
+             eoInit<EOT>& init,
+             eoEvalFunc<EOT>& fullEval,
+             moContinuator<Ngh>& checkpointGlobal)
+      : moLocalSearch<Ngh>(localSearch.getNeighborhoodExplorer(),
+                           checkpointGlobal,
+                           fullEval),
+        localSearch{localSearch},
+        init{init},
+        fullEval{fullEval},
+        checkpointGlobal{checkpointGlobal} {}
+
+  auto operator()(EOT& _solution) -> bool override {
+    moNeighborhoodExplorer<Ngh>& explorer =
+        localSearch.getNeighborhoodExplorer();
+    moContinuator<Ngh>& checkpoint = *localSearch.getContinuator();
+
+    auto start = Clock::now();
+    if (_solution.invalid())
+      fullEval(_solution);
+    checkpointGlobal.init(_solution);
+    EOT current = _solution;
+    bool restarted = false;
+    do {
+      if (restarted) {
+        init(current);
+        current.invalidate();
+        fullEval(current);
+        noRestarts++;
+      }
+      checkpoint.init(current);
+      explorer.initParam(current);
+      setup += Clock::now() - start;
+
+      start = Clock::now();
+      bool cont = true;
+      do {
+        explorer(current);
+        if (explorer.accept(current)) {
+          explorer.move(current);
+          explorer.moveApplied(true);
+        } else {
+          explorer.moveApplied(false);
+        }
+        explorer.updateParam(current);
+        cont = checkpoint(current);
+      } while (cont && explorer.isContinue(current));
+      explorer.terminate(current);
+      search += Clock::now() - start;
+
+      start = Clock::now();
+      if (compare(_solution, current))
+        _solution = current;
+      restarted = true;
+    } while (checkpointGlobal(current));
+    checkpoint.lastCall(current);
+    checkpointGlobal.lastCall(_solution);
+    setup += Clock::now() - start;
+    return true;
+  }
+
+  /** Milliseconds spent restarting, evaluating and initializing. */
+  [[nodiscard]] auto setupTime() const -> double {
+    return std::chrono::duration<double, std::milli>(setup).count();
+  }
+
+  /** Milliseconds spent in the local search. */
+  [[nodiscard]] auto searchTime() const -> double {
+    return std::chrono::duration<double, std::milli>(search).count();
+  }
+
+  [[nodiscard]] auto restarts() const -> unsigned long { return noRestarts; }
+
+ private:
+  moLocalSearch<Ngh>& localSearch;
+  eoInit<EOT>& init;
+  eoEvalFunc<EOT>& fullEval;
+  moContinuator<Ngh>& checkpointGlobal;
+  moSolComparator<EOT> compare;
+  Clock::duration setup{};
+  Clock::duration search{};
+  unsigned long noRestarts = 0;
+};
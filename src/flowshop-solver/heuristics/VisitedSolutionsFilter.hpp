@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/PermutationHash.hpp"
+
+/**
+ * Fixed size open addressing table of 64-bit solution hashes. When the probe
+ * sequence is full the home slot is overwritten, so memory stays bounded and
+ * old entries are forgotten.
+ */
+class VisitedSolutionsTable : public eoFunctorBase {
+  static constexpr unsigned maxProbes = 8;
+
+  std::vector<uint64_t> slots;
+  uint64_t mask;
+  long noLookups = 0;
+  long noHits = 0;
+
+  static auto roundUpPow2(unsigned n) -> unsigned {
+    unsigned p = 1;
+    while (p < n)
+      p <<= 1u;
+    return p;
+  }
+
+ public:
+  explicit VisitedSolutionsTable(unsigned capacity)
+      : slots(roundUpPow2(std::max(capacity, maxProbes)), 0),
+        mask{slots.size() - 1} {}
+
+  /**
+   * Slot of the hash, which is stored there if needed. `found` tells whether
+   * it was already stored.
+   */
+  auto insert(uint64_t hash, bool& found) -> std::size_t {
+    // zero marks an empty slot
+    if (hash == 0)
+      hash = 1;
+    const uint64_t home = hash & mask;
+    found = false;
+    for (unsigned probe = 0; probe < maxProbes; probe++) {
+      const std::size_t index = (home + probe) & mask;
+      if (slots[index] == hash) {
+        found = true;
+        return index;
+      }
+      if (slots[index] == 0) {
+        slots[index] = hash;
+        return index;
+      }
+    }
+    slots[home] = hash;
+    return home;
+  }
+
+  /**
+   * Stores the hash without counting a lookup.
+   * Returns true if it was already stored.
+   */
+  auto add(uint64_t hash) -> bool {
+    bool found;
+    insert(hash, found);
+    return found;
+  }
+
+  /** Counted insert. */
+  auto lookup(uint64_t hash, bool& hit) -> std::size_t {
+    noLookups++;
+    const std::size_t index = insert(hash, hit);
+    if (hit)
+      noHits++;
+    return index;
+  }
+
+  /**
+   * Counted lookup: returns true if the hash was visited before and stores
+   * it otherwise.
+   */
+  auto visited(uint64_t hash) -> bool {
+    bool hit;
+    lookup(hash, hit);
+    return hit;
+  }
+
+  void clear() {
+    std::fill(slots.begin(), slots.end(), 0);
+    noLookups = noHits = 0;
+  }
+
+  [[nodiscard]] auto capacity() const -> std::size_t { return slots.size(); }
+  [[nodiscard]] auto lookups() const -> long { return noLookups; }
+  [[nodiscard]] auto hits() const -> long { return noHits; }
+  [[nodiscard]] auto hitRate() const -> double {
+    return noLookups == 0 ? 0.0 : static_cast<double>(noHits) / noLookups;
+  }
+
+  friend auto operator<<(std::ostream& os, const VisitedSolutionsTable& t)
+      -> std::ostream& {
+    return os << t.lookups() << ',' << t.hits() << ',' << t.hitRate();
+  }
+};
+
+/**
+ * Skips the wrapped local search when the starting solution (usually the
+ * result of a reconstruction) was already visited, and returns the local
+ * optimum found from it instead.
+ *
+ * Only hashes are stored in the table. The local optima are kept in a
+ * direct-mapped cache keyed by the hash of their start, with at most
+ * maxOptima entries, so the copies take at most maxOptima * N jobs whatever
+ * the table size. Visited starts whose optimum was evicted are searched again.
+ */
+template <class Ngh, class EOT = typename Ngh::EOT>
+class VisitedFilterLocalSearch : public moLocalSearch<Ngh> {
+  static constexpr std::size_t maxOptima = 4096;
+
+  struct CachedOptimum {
+    uint64_t start = 0;
+    EOT optimum;
+  };
+
+  moLocalSearch<Ngh>& localSearch;
+  VisitedSolutionsTable& visitedTable;
+  std::vector<CachedOptimum> optima;
+
+ public:
+  VisitedFilterLocalSearch(moLocalSearch<Ngh>& localSearch,
+                           VisitedSolutionsTable& visitedTable,
+                           moContinuator<Ngh>& continuator,
+                           eoEvalFunc<EOT>& fullEval)
+      : moLocalSearch<Ngh>(localSearch.getNeighborhoodExplorer(),
+                           continuator,
+                           fullEval),
+        localSearch(localSearch),
+        visitedTable(visitedTable),
+        // both sizes are powers of two
+        optima(std::min(visitedTable.capacity(), maxOptima)) {}
+
+  auto operator()(EOT& sol) -> bool override {
+    // zero marks an empty entry
+    const uint64_t start = std::max<uint64_t>(permutationHash(sol), 1);
+    CachedOptimum& cached = optima[start & (optima.size() - 1)];
+    if (visitedTable.visited(start) && cached.start == start) {
+      sol = cached.optimum;
+      return false;
+    }
+    const bool ret = localSearch(sol);
+    cached.start = start;
+    cached.optimum = sol;
+    return ret;
+  }
+};
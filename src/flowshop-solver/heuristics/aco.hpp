@@ -4,7 +4,12 @@
 #include <paradiseo/mo/mo>
 
 #include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "flowshop-solver/MHParamsValues.hpp"
 #include "flowshop-solver/heuristics/IGexplorer.hpp"
@@ -12,19 +17,63 @@
 #include "flowshop-solver/heuristics.hpp"
 #include "flowshop-solver/FSPProblemFactory.hpp"
 #include "flowshop-solver/MHParamsSpecsFactory.hpp"
+#include "flowshop-solver/ThreadPool.hpp"
+#include "flowshop-solver/global.hpp"
+#include "flowshop-solver/problems/FSPProblemCopies.hpp"
 
+/**
+ * Max-min ant system used as the perturbation of an ILS. Pheromones are kept
+ * in a flat row-major matrix where row i holds the desire of each job for
+ * position i.
+ *
+ * Ants are built in place: unscheduled jobs live in a candidate list that
+ * shrinks by swapping the chosen job with the last one, and roulette sampling
+ * draws from running prefix sums with a binary search, so no memory is
+ * allocated per ant. When more than one ant is requested they are built
+ * concurrently, each with its own random stream, evaluated in order and the
+ * best one is returned.
+ *
+ * Evaporation is lazy: stored values are multiplied by a common scale, so an
+ * update only writes the N entries of the deposited solution. The MMAS lower
+ * bound is applied when a value is read, which gives the same trails as
+ * clamping the whole matrix after every evaporation.
+ */
 template <class Ngh>
 class MinMaxAntSystem : public moPerturbation<Ngh> {
  public:
   using EOT = typename Ngh::EOT;
-  using dvec = std::vector<double>;
-  using dmat = std::vector<dvec>;
 
   MinMaxAntSystem(const int N,
                   const double t_min_f,
                   const double rho,
                   const double p0)
-      : moPerturbation<Ngh>{}, N(N), t_min_f(t_min_f), rho(rho), p0(p0) {}
+      : moPerturbation<Ngh>{},
+        N(N),
+        t_min_f(t_min_f),
+        rho(rho),
+        p0(p0),
+        scratches(1) {}
+
+  MinMaxAntSystem(const int N,
+                  const double t_min_f,
+                  const double rho,
+                  const double p0,
+                  eoEvalFunc<EOT>& fullEval,
+                  const unsigned noAnts,
+                  const unsigned noThreads = 1)
+      : moPerturbation<Ngh>{},
+        N(N),
+        t_min_f(t_min_f),
+        rho(rho),
+        p0(p0),
+        fullEval(&fullEval),
+        scratches(std::max(noAnts, 1u)) {
+    if (noAnts > 1) {
+      ants.resize(noAnts, EOT(N));
+      if (noThreads > 1)
+        pool = std::make_unique<ThreadPool>(std::min(noThreads, noAnts));
+    }
+  }
 
   /**
    * Init the memory
@@ -32,49 +81,35 @@ class MinMaxAntSystem : public moPerturbation<Ngh> {
    */
   void init(EOT& _sol) final {
     // Set parameters, initialize pheromone trails
-    t_max = 1.0 / ((1 - rho) * _sol.fitness());
-    t_min = t_min_f * t_max;
-    pheromones.assign(N, dvec(N, t_max));
-    Ngh dummy;
-    // add(_sol, dummy);
+    setBounds(_sol.fitness());
+    pheromones.assign(N * N, t_max);
+    scale = 1.0;
+    streams.clear();
+    for (unsigned k = 0; k < ants.size(); k++)
+      streams.push_back(std::make_unique<RNG::Stream>(RNG::engine()));
   }
 
   auto operator()(EOT& sol) -> bool final {
-    // ConstructSolutions
-    sol.invalidate();
-    sol.resize(0);
-    sol.reserve(N);
-    dmat probs = pheromones;
-    int chosen_job = -1;
-    for (int j = 0; j < N; j++) {
-      if (rng.uniform() < p0) {
-        // find the job that has the higher desire to be in j th position
-        chosen_job = maxCoeffCol(probs, j);
-      } else {
-        double sum = sumCol(probs, j);
-        if (sum <= 1e-6) {
-          // choose randomly if there are not enough values (or all ties at
-          // zero)
-          do {
-            chosen_job = std::floor(rng.uniform(N));
-          } while (std::find(sol.begin(), sol.end(), chosen_job) != sol.end());
-        } else {
-          // use the probabilities as a distribution
-          double r = rng.uniform(sum);
-          double cum_sum = 0.0;
-          chosen_job = -1;
-          do {
-            chosen_job++;
-            cum_sum += probs[j][chosen_job];
-          } while (cum_sum < r);
-        }
-      }
-      sol.push_back(chosen_job);
-
-      for (int row = 0; row < N; row++) {
-        probs[row][chosen_job] = 0.0;
-      }
+    if (ants.empty()) {
+      construct(sol, RNG::paradiseo(), scratches[0]);
+      return true;
+    }
+    const auto buildAnt = [&](unsigned k) {
+      construct(ants[k], streams[k]->paradiseo, scratches[k]);
+    };
+    if (pool) {
+      pool->parallelFor(ants.size(), buildAnt);
+    } else {
+      for (unsigned k = 0; k < ants.size(); k++)
+        buildAnt(k);
     }
+    unsigned best = 0;
+    for (unsigned k = 0; k < ants.size(); k++) {
+      (*fullEval)(ants[k]);
+      if (ants[k].fitness() > ants[best].fitness())
+        best = k;
+    }
+    sol = ants[best];
     return true;
   }
 
@@ -90,16 +125,91 @@ class MinMaxAntSystem : public moPerturbation<Ngh> {
    * @param _sol the current solution
    * @param _neighbor the current neighbor
    */
-  void update(EOT& _sol, Ngh&) final {
-    // UpdateTrails
+  void update(EOT& _sol, Ngh&) final { deposit(_sol); }
+
+  /**
+   * Evaporates all trails and deposits on the positions of `sol`, touching
+   * only N stored values.
+   */
+  void deposit(const EOT& sol) {
+    const double amount = 1.0 / sol.fitness();
+    const double nextScale = scale * rho;
     for (int i = 0; i < N; i++) {
-      for (int j = 0; j < N; j++) {
-        double val = rho * pheromones[i][j];
-        if (_sol[i] == j)
-          val += 1.0 / _sol.fitness();
-        pheromones[i][j] = clamp(val, t_min, t_max);
+      double& stored = pheromones[i * N + sol[i]];
+      const double val = rho * std::max(t_min, stored * scale) + amount;
+      stored = clamp(val, t_min, t_max) / nextScale;
+    }
+    scale = nextScale;
+    if (scale < 1e-100)
+      rescale();
+  }
+
+  /**
+   * MMAS bounds for the best fitness found so far.
+   */
+  void setBounds(double bestFitness) {
+    t_max = 1.0 / ((1 - rho) * bestFitness);
+    t_min = t_min_f * t_max;
+  }
+
+  [[nodiscard]] auto pheromone(int position, int job) const -> double {
+    return std::max(t_min, pheromones[position * N + job] * scale);
+  }
+
+  /** Buffers reused by the construction of one ant. */
+  struct AntScratch {
+    std::vector<int> candidates;
+    std::vector<double> cumulative;
+  };
+
+  /**
+   * Builds one ant into `sol` from the current trails. Only reads the trails,
+   * so ants with their own scratch and generator can be built concurrently.
+   */
+  void construct(EOT& sol, eoRng& random, AntScratch& scratch) const {
+    auto& candidates = scratch.candidates;
+    auto& cumulative = scratch.cumulative;
+    candidates.resize(N);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    cumulative.resize(N);
+    sol.resize(N);
+    for (int j = 0; j < N; j++) {
+      const int noCandidates = N - j;
+      int chosen = 0;
+      if (random.uniform() < p0) {
+        // the job that has the higher desire to be in j th position
+        double best = pheromone(j, candidates[0]);
+        for (int c = 1; c < noCandidates; c++) {
+          const double value = pheromone(j, candidates[c]);
+          if (best < value) {
+            best = value;
+            chosen = c;
+          }
+        }
+      } else {
+        double sum = 0.0;
+        for (int c = 0; c < noCandidates; c++) {
+          sum += pheromone(j, candidates[c]);
+          cumulative[c] = sum;
+        }
+        if (sum <= 1e-6) {
+          // choose randomly if there are not enough values (or all ties at
+          // zero)
+          chosen = random.random(noCandidates);
+        } else {
+          // use the probabilities as a distribution
+          const double r = random.uniform(sum);
+          const auto end = cumulative.begin() + noCandidates;
+          chosen = std::min<int>(
+              std::distance(cumulative.begin(),
+                            std::upper_bound(cumulative.begin(), end, r)),
+              noCandidates - 1);
+        }
       }
+      sol[j] = candidates[chosen];
+      candidates[chosen] = candidates[noCandidates - 1];
     }
+    sol.invalidate();
   }
 
   /**
@@ -108,47 +218,35 @@ class MinMaxAntSystem : public moPerturbation<Ngh> {
   void clearMemory() final{};
 
  private:
+  void rescale() {
+    for (auto& stored : pheromones)
+      stored *= scale;
+    scale = 1.0;
+  }
+
   // parameters
   const int N;
   const double t_min_f, rho, p0;
+  eoEvalFunc<EOT>* fullEval = nullptr;
 
   // aux
   double t_min, t_max;
-  dmat pheromones, prob;
-
-  auto maxCoeffCol(const dmat& matrix, int row) -> int {
-    double max = matrix[row][0];
-    int ret = 0;
-    for (unsigned col = 1; col < matrix.size(); col++) {
-      if (max < matrix[row][col]) {
-        max = matrix[row][col];
-        ret = static_cast<int>(col);
-      }
-    }
-    return ret;
-  }
-
-  auto sumCol(const dmat& matrix, int row) -> double {
-    double s = 0.0;
-    for (unsigned col = 1; col < matrix.size(); col++) {
-      s += matrix[row][col];
-    }
-    return s;
-  }
+  // trail of job j at position i is max(t_min, pheromones[i * N + j] * scale)
+  std::vector<double> pheromones;
+  double scale = 1.0;
+  std::vector<AntScratch> scratches;
+  std::vector<EOT> ants;
+  std::vector<std::unique_ptr<RNG::Stream>> streams;
+  std::unique_ptr<ThreadPool> pool;
 };
 
-template <class Ngh, class EOT = typename Problem<Ngh>::EOT>
-auto solveWithACO(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
-  const int N = prob.size(0);
-  const int max_nh_size = pow(N - 1, 2);
-
-  // continuator
-  eoEvalFunc<EOT>& fullEval = prob.eval();
-  moEval<Ngh>& evalN = prob.neighborEval();
-
-  moCheckpoint<Ngh>& checkpoint = prob.checkpoint();
-  moCheckpoint<Ngh>& checkpointGlobal = prob.checkpointGlobal();
-
+/**
+ * Local search of the ACO configured from the ACO.* parameters. It is built on
+ * one problem, so concurrent ants can each improve their solution on their own
+ * problem copy.
+ */
+template <class Ngh, class EOT = typename Ngh::EOT>
+class ACOLocalSearch {
   // comparator strategy
   moSolComparator<EOT> compSS0;               // comp sol/sol strict
   moSolNeighborComparator<Ngh> compSN0;       // comp sol/Ngh strict
@@ -159,100 +257,220 @@ auto solveWithACO(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
   moSolComparator<EOT>* compSS = nullptr;
   moSolNeighborComparator<Ngh>* compSN = nullptr;
   moNeighborComparator<Ngh>* compNN = nullptr;
-  switch (params.categorical("ACO.Comp.Strat")) {
-    case 0:
-      compSS = &compSS0;
-      compSN = &compSN0;
-      compNN = &compNN0;
-      break;
-    case 1:
-      compSS = &compSS1;
-      compSN = &compSN1;
-      compNN = &compNN1;
-      break;
-    default:
-      assert(false);
-      break;
-  }
 
-  // initialization
-  eoInit<EOT>* init = nullptr;
-
-  // neighborhood size
-  const int min_nh_size = (N >= 20) ? 11 : 2;
-  const int nh_interval = (N >= 20) ? 10 : 1;
-  const int no_nh_sizes = (max_nh_size - min_nh_size) / nh_interval + 1;
-  const int scale = int(static_cast<float>(no_nh_sizes) *
-                        params.real("ACO.Neighborhood.Size") / 10.0);
-  const int nh_size = std::min(max_nh_size, min_nh_size + scale * nh_interval);
-
-  moOrderNeighborhood<Ngh> neighborhood0(nh_size);
-  moRndWithoutReplNeighborhood<Ngh> neighborhood1(nh_size);
-  moNeighborhood<Ngh>* neighborhood = nullptr;
-  switch (params.categorical("ACO.Neighborhood.Strat")) {
-    case 0:
-      neighborhood = &neighborhood0;
-      break;
-    case 1:
-      neighborhood = &neighborhood1;
-      break;
-    default:
-      assert(false);
-      break;
-  }
+  std::unique_ptr<moNeighborhood<Ngh>> neighborhood;
+  std::unique_ptr<IGexplorer<Ngh>> igexplorer;
+  std::unique_ptr<moLocalSearch<Ngh>> algo;
+  moCombinedContinuator<Ngh> singleStepContinuator;
+  falseContinuator<Ngh> falseCont;
 
-  // algos xxHC
-  moFirstImprHC<Ngh> algo0(*neighborhood, fullEval, evalN, checkpoint, *compNN,
-                           *compSN);  // FIHC
-  moSimpleHC<Ngh> algo1(*neighborhood, fullEval, evalN, checkpoint, *compNN,
-                        *compSN);  // BestHC
-  moRandomBestHC<Ngh> algo2(*neighborhood, fullEval, evalN, checkpoint, *compNN,
-                            *compSN);  // rndBestHC
-
-  // IG (Ruiz+Stuetzle)
-  // iterative greedy improvement without replacement (IG)
-  // FastIGexplorer igexplorer(evalN, *compNN, *compSN);
-  IGexplorer<Ngh> igexplorer(fullEval, N, *compSS);
-  moLocalSearch<Ngh> algo3(igexplorer, checkpoint, fullEval);
-  moLocalSearch<Ngh>* algo;
-  switch (params.categorical("ACO.Local.Search")) {
-    case 0:
-      algo = &algo0;
-      break;
-    case 1:
-      algo = &algo1;
-      break;
-    case 2:
-      algo = &algo2;
-      break;
-    case 3:
-     algo = &algo3;
-     break;
-    default:
-      assert(false);
-      break;
-  }
+ public:
+  ACOLocalSearch(Problem<Ngh>& prob, const MHParamsValues& params)
+      : singleStepContinuator{prob.checkpoint()} {
+    const int N = prob.size(0);
+    const int max_nh_size = pow(N - 1, 2);
 
-  moCombinedContinuator<Ngh> singleStepContinuator(checkpoint);
-  falseContinuator<Ngh> falseCont;
-  singleStepContinuator.add(falseCont);
-  if (params.categorical("ACO.LS.Single.Step")) {
-    algo->setContinuator(singleStepContinuator);
+    eoEvalFunc<EOT>& fullEval = prob.eval();
+    moEval<Ngh>& evalN = prob.neighborEval();
+    moCheckpoint<Ngh>& checkpoint = prob.checkpoint();
+
+    switch (params.categorical("ACO.Comp.Strat")) {
+      case 0:
+        compSS = &compSS0;
+        compSN = &compSN0;
+        compNN = &compNN0;
+        break;
+      case 1:
+        compSS = &compSS1;
+        compSN = &compSN1;
+        compNN = &compNN1;
+        break;
+      default:
+        assert(false);
+        break;
+    }
+
+    // neighborhood size
+    const int min_nh_size = (N >= 20) ? 11 : 2;
+    const int nh_interval = (N >= 20) ? 10 : 1;
+    const int no_nh_sizes = (max_nh_size - min_nh_size) / nh_interval + 1;
+    const int scale = int(static_cast<float>(no_nh_sizes) *
+                          params.real("ACO.Neighborhood.Size") / 10.0);
+    const int nh_size =
+        std::min(max_nh_size, min_nh_size + scale * nh_interval);
+
+    switch (params.categorical("ACO.Neighborhood.Strat")) {
+      case 0:
+        neighborhood = std::make_unique<moOrderNeighborhood<Ngh>>(nh_size);
+        break;
+      case 1:
+        neighborhood =
+            std::make_unique<moRndWithoutReplNeighborhood<Ngh>>(nh_size);
+        break;
+      default:
+        assert(false);
+        break;
+    }
+
+    switch (params.categorical("ACO.Local.Search")) {
+      case 0:  // FIHC
+        algo = std::make_unique<moFirstImprHC<Ngh>>(
+            *neighborhood, fullEval, evalN, checkpoint, *compNN, *compSN);
+        break;
+      case 1:  // BestHC
+        algo = std::make_unique<moSimpleHC<Ngh>>(
+            *neighborhood, fullEval, evalN, checkpoint, *compNN, *compSN);
+        break;
+      case 2:  // rndBestHC
+        algo = std::make_unique<moRandomBestHC<Ngh>>(
+            *neighborhood, fullEval, evalN, checkpoint, *compNN, *compSN);
+        break;
+      case 3:
+        // IG (Ruiz+Stuetzle)
+        // iterative greedy improvement without replacement (IG)
+        igexplorer = std::make_unique<IGexplorer<Ngh>>(evalN, N, *compSS);
+        algo = std::make_unique<moLocalSearch<Ngh>>(*igexplorer, checkpoint,
+                                                    fullEval);
+        break;
+      default:
+        assert(false);
+        break;
+    }
+
+    singleStepContinuator.add(falseCont);
+    if (params.categorical("ACO.LS.Single.Step")) {
+      algo->setContinuator(singleStepContinuator);
+    }
   }
 
+  auto operator()() -> moLocalSearch<Ngh>& { return *algo; }
+};
+
+template <class Ngh, class EOT = typename Problem<Ngh>::EOT>
+auto solveWithACO(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
+  const int N = prob.size(0);
+
+  // continuator
+  eoEvalFunc<EOT>& fullEval = prob.eval();
+  moCheckpoint<Ngh>& checkpointGlobal = prob.checkpointGlobal();
+
+  // initialization, the ants build the next solutions
+  eoInitPermutation<EOT> init(N);
+
+  ACOLocalSearch<Ngh> localSearch(prob, params);
+
   moAlwaysAcceptCrit<Ngh> accept;
 
   /****
   *** Perturb
   ****/
 
+  const unsigned noAnts = std::stoi(params.categoricalName("ACO.Ants", "1"));
+  const unsigned noThreads =
+      std::stoi(params.categoricalName("ACO.Threads", "1"));
   MinMaxAntSystem<Ngh> perturb(N, params.real("ACO.T.Min.Factor"),
-                               params.real("ACO.Rho"), params.real("ACO.P0"));
+                               params.real("ACO.Rho"), params.real("ACO.P0"),
+                               fullEval, noAnts, noThreads);
 
   /****
   *** ILS
   ****/
-  moILS<Ngh, Ngh> ils(*algo, fullEval, checkpointGlobal, perturb, accept);
+  moILS<Ngh, Ngh> ils(localSearch(), fullEval, checkpointGlobal, perturb,
+                      accept);
+
+  return runExperiment(init, ils, prob);
+}
+
+/**
+ * MMAS colony: every iteration builds ACO.Ants ants and improves each one with
+ * the local search. With more than one thread, ants are built and improved
+ * concurrently, each on its own problem copy and random stream. Pheromones are
+ * then deposited from the iteration best or from the global best ant
+ * (ACO.Update), which is O(N) thanks to the lazy evaporation of the trails.
+ * The budget is checked by each ant on its own copy, so concurrent ants of
+ * the last iteration may each spend the whole remaining budget.
+ */
+inline auto solveWithACOColony(FSPProblem& prob,
+                               const MHParamsValues& params,
+                               RunOptions options = RunOptions()) -> Result {
+  using Ngh = FSPNeighbor;
+  using EOT = FSP;
+  const int N = prob.size(0);
+  const unsigned noAnts =
+      std::max(std::stoi(params.categoricalName("ACO.Ants", "1")), 1);
+  const unsigned noThreads = std::min<unsigned>(
+      std::stoi(params.categoricalName("ACO.Threads", "1")), noAnts);
+  const bool globalBestUpdate =
+      params.categoricalName("ACO.Update", "iteration_best") == "global_best";
+
+  if (noThreads > 1 && (params.categorical("ACO.Neighborhood.Strat") == 1 ||
+                        params.categorical("ACO.Local.Search") == 2)) {
+    throw std::runtime_error(
+        "ACO colony threads need a local search with a deterministic "
+        "neighborhood: the random ones share the global generator");
+  }
 
-  return runExperiment(*init, ils, prob);
+  MinMaxAntSystem<Ngh> mmas(N, params.real("ACO.T.Min.Factor"),
+                            params.real("ACO.Rho"), params.real("ACO.P0"));
+
+  FSPProblemCopies copies(prob, noThreads > 1 ? noAnts : 0);
+  std::vector<std::unique_ptr<ACOLocalSearch<Ngh>>> localSearches;
+  if (copies.size() == 0) {
+    localSearches.push_back(std::make_unique<ACOLocalSearch<Ngh>>(prob, params));
+  } else {
+    for (unsigned k = 0; k < noAnts; k++)
+      localSearches.push_back(
+          std::make_unique<ACOLocalSearch<Ngh>>(copies[k], params));
+  }
+  const auto antProblem = [&](unsigned k) -> FSPProblem& {
+    return copies.size() == 0 ? prob : copies[k];
+  };
+  const auto antLocalSearch = [&](unsigned k) -> moLocalSearch<Ngh>& {
+    return (*localSearches[copies.size() == 0 ? 0 : k])();
+  };
+
+  std::vector<EOT> ants(noAnts, EOT(N));
+  std::vector<MinMaxAntSystem<Ngh>::AntScratch> scratches(noAnts);
+  std::vector<std::unique_ptr<RNG::Stream>> streams;
+  for (unsigned k = 0; k < noAnts; k++)
+    streams.push_back(std::make_unique<RNG::Stream>(RNG::engine()));
+  ThreadPool pool(noThreads);
+
+  const auto buildAnt = [&](unsigned k) {
+    RNG::StreamGuard guard(*streams[k]);
+    FSPProblem& antProb = antProblem(k);
+    mmas.construct(ants[k], streams[k]->paradiseo, scratches[k]);
+    antProb.eval()(ants[k]);
+    antProb.checkpoint().init(ants[k]);
+    antLocalSearch(k)(ants[k]);
+    antProb.checkpoint().lastCall(ants[k]);
+  };
+
+  return runSearchExperiment(
+      prob,
+      [&](EOT& best) {
+        eoInitPermutation<EOT> init(N);
+        init(best);
+        prob.eval()(best);
+        mmas.init(best);
+        prob.checkpoint().init(best);
+        prob.checkpointGlobal().init(best);
+        while (prob.checkpointGlobal()(best)) {
+          copies.sync();
+          pool.parallelFor(noAnts, buildAnt);
+          copies.merge();
+          unsigned iterationBest = 0;
+          for (unsigned k = 1; k < noAnts; k++)
+            if (ants[k].fitness() > ants[iterationBest].fitness())
+              iterationBest = k;
+          if (ants[iterationBest].fitness() > best.fitness()) {
+            best = ants[iterationBest];
+            mmas.setBounds(best.fitness());
+          }
+          mmas.deposit(globalBestUpdate ? best : ants[iterationBest]);
+        }
+        prob.checkpoint().lastCall(best);
+        prob.checkpointGlobal().lastCall(best);
+      },
+      options);
 }
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <paradiseo/mo/mo>
+#include <memory>
 #include <unordered_map>
 
+#include "flowshop-solver/aos/aos_state.hpp"
+#include "flowshop-solver/aos/aos_trace.hpp"
 #include "flowshop-solver/continuators/myTimeStat.hpp"
 #include "flowshop-solver/heuristics.hpp"
 #include "flowshop-solver/heuristics/aco.hpp"
@@ -14,11 +17,14 @@
 #include "flowshop-solver/heuristics/sa.hpp"
 #include "flowshop-solver/heuristics/ts.hpp"
 #include "flowshop-solver/heuristics/IGBP.hpp"
+#include "flowshop-solver/heuristics/ma.hpp"
 #include "flowshop-solver/heuristics/neh.hpp"
 
+#include "flowshop-solver/ParamsPolicy.hpp"
 #include "flowshop-solver/RunOptions.hpp"
 #include "flowshop-solver/eoFSPFactory.hpp"
 #include "flowshop-solver/heuristics/FitnessReward.hpp"
+#include "flowshop-solver/problems/FSPInstanceFeatures.hpp"
 
 template <class EOT>
 class RewardPrinter : public moStatBase<EOT> {
@@ -42,6 +48,21 @@ class RewardPrinter : public moStatBase<EOT> {
   }
 };
 
+/**
+ * Features of the instance and run that key the learned AOS states, e.g.
+ * FSP/PERM/MAKESPAN/med/FIXEDTIME/20x5.
+ */
+inline auto aosStateFeatures(
+    const std::unordered_map<std::string, std::string>& problem_specs,
+    const FSPProblem& prob) -> std::string {
+  std::string features;
+  for (const auto& name : {"problem", "type", "objective", "budget",
+                           "stopping_criterion"})
+    features += problem_specs.at(name) + '/';
+  return features + std::to_string(prob.data().noJobs()) + 'x' +
+         std::to_string(prob.data().noMachines());
+}
+
 inline auto solveWith(
     std::string mh,
     const std::unordered_map<std::string, std::string>& problem_specs,
@@ -50,8 +71,17 @@ inline auto solveWith(
   FSPProblem prob = FSPProblemFactory::get(problem_specs);
   MHParamsSpecs specs = MHParamsSpecsFactory::get(mh);
   MHParamsValues params(&specs);
-  params.readValues(params_values);
+  if (runOptions.policy.empty()) {
+    params.readValues(params_values);
+  } else {
+    auto values = params_values;
+    ParamsPolicy(runOptions.policy).apply(instanceFeatures(prob.data()),
+                                          values);
+    params.readValues(values);
+  }
 
+  // outlives the factory, which releases its operator selections into it
+  std::unique_ptr<AOSStateStore> aosStates;
   eoFSPFactory factory{params, prob};
 
   if (mh == "all") {
@@ -67,27 +97,56 @@ inline auto solveWith(
     prob.checkpointGlobal().add(rewardPrinter);
   }
 
-  if (mh == "NEH")
-    return solveWithNEH(prob, factory, runOptions);
-  else if (mh == "HC")
-    return solveWithHC(prob, factory, runOptions);
-  else if (mh == "SA")
-    return solveWithSA(prob, params);
-  else if (mh == "IHC")
-    return solveWithIHC(prob, params);
-  else if (mh == "ISA")
-    return solveWithISA(prob, params);
-  else if (mh == "TS")
-    return solveWithTS(prob, params);
-  else if (mh == "IG")
-    return solveWithIG(prob, factory, runOptions);
-  else if (mh == "ILS")
-    return solveWithILS(prob, params);
-  else if (mh == "ACO")
-    return solveWithACO(prob, params);
-  else if (mh == "IGBP")
-    return solveWithIGBP(prob, params, runOptions);
-  else
-    throw std::runtime_error("Unknown MH: " + mh);
-  return {};
+  std::unique_ptr<AOSTraceWriter> trace;
+  std::unique_ptr<AOSTraceFitness<FSP>> traceFitness;
+  if (!runOptions.aosTrace.empty()) {
+    trace = std::make_unique<AOSTraceWriter>(runOptions.aosTrace);
+    traceFitness = std::make_unique<AOSTraceFitness<FSP>>(*trace);
+    factory.traceOperatorSelection(*trace);
+    prob.checkpoint().add(*traceFitness);
+    prob.checkpointGlobal().add(*traceFitness);
+  }
+
+  if (!runOptions.aosState.empty()) {
+    aosStates = std::make_unique<AOSStateStore>(runOptions.aosState);
+    factory.persistOperatorSelection(*aosStates,
+                                     aosStateFeatures(problem_specs, prob),
+                                     runOptions.aosWarmStart);
+  }
+
+  auto solve = [&]() -> Result {
+    if (mh == "NEH" || mh == "BEAM")
+      return solveWithNEH(prob, factory, runOptions);
+    else if (mh == "HC")
+      return solveWithHC(prob, factory, runOptions);
+    else if (mh == "SA")
+      return solveWithSA(prob, params);
+    else if (mh == "IHC")
+      return solveWithIHC(prob, params);
+    else if (mh == "ISA")
+      return solveWithISA(prob, factory, params, runOptions);
+    else if (mh == "TS")
+      return solveWithTS(prob, params);
+    else if (mh == "IG")
+      return solveWithIG(prob, factory, runOptions);
+    else if (mh == "ILS")
+      return solveWithILS(prob, params);
+    else if (mh == "ACO" &&
+             params.categoricalName("ACO.Mode", "ils") == "colony")
+      return solveWithACOColony(prob, params, runOptions);
+    else if (mh == "ACO")
+      return solveWithACO(prob, params);
+    else if (mh == "MA")
+      return solveWithMA(prob, factory, params, runOptions);
+    else if (mh == "IGBP")
+      return solveWithIGBP(prob, factory, params, runOptions);
+    else
+      throw std::runtime_error("Unknown MH: " + mh);
+    return {};
+  };
+
+  Result result = solve();
+  if (aosStates)
+    aosStates->save();
+  return result;
 }
\ No newline at end of file
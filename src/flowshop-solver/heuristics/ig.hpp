@@ -7,6 +7,7 @@
 #include "flowshop-solver/heuristics.hpp"
 #include "flowshop-solver/RunOptions.hpp"
 #include "flowshop-solver/eoFactory.hpp"
+#include "flowshop-solver/heuristics/VisitedSolutionsFilter.hpp"
 
 template <class Ngh, class EOT = typename Problem<Ngh>::EOT>
 auto solveWithIG(Problem<Ngh>& prob,
@@ -16,6 +17,21 @@ auto solveWithIG(Problem<Ngh>& prob,
   auto algo = factory.buildLocalSearch();
   auto accept = factory.buildAcceptanceCriterion();
   auto perturb = factory.buildPerturb();
+
+  VisitedSolutionsTable* visitedTable = nullptr;
+  if (factory.categoricalName(".VisitedFilter", "none") == "table") {
+    const auto size = static_cast<unsigned>(
+        std::stoi(factory.categoricalName(".VisitedFilter.Size", "16384")));
+    visitedTable = &factory.template pack<VisitedSolutionsTable>(size);
+    algo = &factory.template pack<VisitedFilterLocalSearch<Ngh>>(
+        *algo, *visitedTable, prob.continuator(), prob.eval());
+  }
+
   moILS<Ngh, Ngh> ils(*algo, prob.eval(), prob.checkpointGlobal(), *perturb, *accept);
-  return runExperiment(*init, ils, prob, runOptions);
+  auto result = runExperiment(*init, ils, prob, runOptions);
+  if (visitedTable != nullptr && runOptions.printVisitedStats) {
+    std::cout << "visited_lookups,visited_hits,visited_hit_rate\n"
+              << *visitedTable << '\n';
+  }
+  return result;
 }
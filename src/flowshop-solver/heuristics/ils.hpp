@@ -94,7 +94,7 @@ auto solveWithILS(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
   // IG (Ruiz+Stuetzle)
   // iterative greedy improvement without replacement (IG)
   // FastIGexplorer igexplorer(evalN, *compNN, *compSN);
-  IGexplorer<Ngh> igexplorer(fullEval, N, *compSS);
+  IGexplorer<Ngh> igexplorer(evalN, N, *compSS);
   moLocalSearch<Ngh> algo3(igexplorer, checkpoint, fullEval);
   moLocalSearch<Ngh>* algo;
   switch (params.categorical("ILS.Algo")) {
@@ -1,15 +1,24 @@
 #pragma once
 
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 #include "flowshop-solver/heuristics.hpp"
 #include "flowshop-solver/MHParamsValues.hpp"
+#include "flowshop-solver/eoFactory.hpp"
+#include "flowshop-solver/RunOptions.hpp"
 #include "flowshop-solver/FSPProblemFactory.hpp"
+#include "flowshop-solver/heuristics/FastSAexplorer.hpp"
+#include "flowshop-solver/heuristics/RestartILS.hpp"
 #include "flowshop-solver/heuristics/op_cooling_schedule.hpp"
 #include "flowshop-solver/MHParamsSpecsFactory.hpp"
 
 template <class Ngh, class EOT = typename Problem<Ngh>::EOT>
-auto solveWithISA(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
+auto solveWithISA(Problem<Ngh>& prob,
+                  eoFactory<Ngh>& factory,
+                  const MHParamsValues& params,
+                  RunOptions runOptions = RunOptions()) -> Result {
   const int N = prob.size(0);
   const int M = prob.size(1);
   const int max_nh_size = pow(N - 1, 2);
@@ -45,7 +54,7 @@ auto solveWithISA(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
   }
 
   // initialization
-  eoInit<EOT>* init = nullptr;
+  eoInit<EOT>* init = factory.buildInit();
 
   // neighborhood size
   const int min_nh_size = (N >= 20) ? 11 : 2;
@@ -87,11 +96,39 @@ auto solveWithISA(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
       break;
   }
 
-  moSA<Ngh> algo(neighborhood, fullEval, evalN, *cooling, *compSN, checkpoint);
+  moSA<Ngh> algo0(neighborhood, fullEval, evalN, *cooling, *compSN,
+                  checkpoint);
+
+  // cached temperatures and cheap acceptance tests
+  const bool fastSA = params.categoricalName("ISA.Fast", "0") == "1";
+  if (fastSA && params.categorical("ISA.Algo") == 1)
+    throw std::runtime_error(
+        "ISA.Fast needs a cooling schedule independent of accepted moves");
+  const unsigned batchSize =
+      std::stoi(params.categoricalName("ISA.Batch.Size", "1"));
+  TemperatureTable<EOT> temperatures(*cooling);
+  FastSAexplorer<Ngh> fastExplorer(neighborhood, evalN, *compSN, temperatures,
+                                   batchSize, &prob.continuator());
+  moLocalSearch<Ngh> algo1(fastExplorer, checkpoint, fullEval);
+
+  moLocalSearch<Ngh>& algo = fastSA ? algo1 : algo0;
 
   moRestartPerturb<Ngh> perturb(*init, fullEval, 0);
   moAlwaysAcceptCrit<Ngh> accept;
-  moILS<Ngh, Ngh> ils(algo, fullEval, checkpointGlobal, perturb, accept);
+  moILS<Ngh, Ngh> ils0(algo, fullEval, checkpointGlobal, perturb, accept);
+
+  // restarts that keep the local search state
+  RestartILS<Ngh> ils1(algo, *init, fullEval, checkpointGlobal);
 
-  return runExperiment(*init, ils, prob);
+  const bool restartDriver =
+      params.categoricalName("ISA.Driver", "ils") == "restart";
+  moLocalSearch<Ngh>& ils = restartDriver ? ils1 : ils0;
+
+  Result result = runExperiment(*init, ils, prob);
+  if (restartDriver && runOptions.printRestartTimes) {
+    std::cout << "restarts,setup_ms,search_ms\n"
+              << ils1.restarts() << ',' << ils1.setupTime() << ','
+              << ils1.searchTime() << '\n';
+  }
+  return result;
 }
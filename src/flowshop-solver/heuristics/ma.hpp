@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/MHParamsValues.hpp"
+#include "flowshop-solver/RunOptions.hpp"
+#include "flowshop-solver/ThreadPool.hpp"
+#include "flowshop-solver/eoFSPFactory.hpp"
+#include "flowshop-solver/global.hpp"
+#include "flowshop-solver/heuristics.hpp"
+#include "flowshop-solver/heuristics/PermutationCrossover.hpp"
+#include "flowshop-solver/heuristics/PopulationArena.hpp"
+#include "flowshop-solver/problems/FSPProblemCopies.hpp"
+
+/**
+ * Workers of the memetic algorithm. With more than one thread, each worker has
+ * its own problem copy, local search and random stream.
+ */
+class MAWorkers {
+  using Ngh = FSPNeighbor;
+
+  FSPProblem& problem;
+  FSPProblemCopies problems;
+  std::vector<std::unique_ptr<eoFSPFactory>> factories;
+  std::vector<std::unique_ptr<RNG::Stream>> streams;
+  std::unique_ptr<ThreadPool> pool;
+
+ public:
+  std::vector<moLocalSearch<Ngh>*> localSearches;
+  std::vector<CrossoverScratch> scratches;
+
+  MAWorkers(FSPProblem& problem,
+            eoFSPFactory& factory,
+            const MHParamsValues& params,
+            unsigned noThreads)
+      : problem{problem},
+        problems{problem, noThreads > 1 ? noThreads : 0u},
+        scratches(std::max(noThreads, 1u)) {
+    if (noThreads <= 1) {
+      localSearches.push_back(factory.buildLocalSearch());
+      return;
+    }
+    for (unsigned w = 0; w < noThreads; w++) {
+      factories.push_back(std::make_unique<eoFSPFactory>(params, problems[w]));
+      localSearches.push_back(factories.back()->buildLocalSearch());
+      streams.push_back(std::make_unique<RNG::Stream>(RNG::engine()));
+    }
+    pool = std::make_unique<ThreadPool>(noThreads);
+  }
+
+  [[nodiscard]] auto size() const -> unsigned { return localSearches.size(); }
+
+  auto workerProblem(unsigned w) -> FSPProblem& {
+    return pool ? problems[w] : problem;
+  }
+
+  /**
+   * Calls work(w, i) for i in [0, n), where worker w handles the indices
+   * i = w (mod size()). Evaluations of the copies are merged back at the end.
+   */
+  template <class Work>
+  void run(unsigned n, Work work) {
+    if (!pool) {
+      for (unsigned i = 0; i < n; i++)
+        work(0u, i);
+      return;
+    }
+    problems.sync();
+    pool->parallelFor(size(), [&](unsigned w) {
+      RNG::StreamGuard guard{*streams[w]};
+      for (unsigned i = w; i < n; i += size())
+        work(w, i);
+    });
+    problems.merge();
+  }
+};
+
+/**
+ * Steady-state memetic algorithm. The population lives in a PopulationArena
+ * and is seeded with the configured initialization (e.g. NEH) plus random
+ * permutations. Every generation creates MA.Offspring children by binary
+ * tournament, OX or PMX crossover and an optional random shift, and improves
+ * them with the local search of the factory, concurrently with MA.Threads.
+ * Each child then replaces the worst individual if it is better and not a
+ * duplicate.
+ */
+inline auto solveWithMA(FSPProblem& prob,
+                        eoFSPFactory& factory,
+                        const MHParamsValues& params,
+                        const RunOptions& runOptions) -> Result {
+  using EOT = FSP;
+  const int N = prob.size(0);
+  const int populationSize =
+      std::stoi(factory.categoricalName(".Population.Size"));
+  const unsigned noOffspring =
+      std::max(std::stoi(factory.categoricalName(".Offspring", "1")), 1);
+  const unsigned noThreads = std::min<unsigned>(
+      std::stoi(factory.categoricalName(".Threads", "1")), noOffspring);
+  const double mutationRate = factory.real(".Mutation.Rate");
+  const auto crossoverName = factory.categoricalName(".Crossover");
+  const PermutationCrossover crossover = permutationCrossover(crossoverName);
+  if (crossover == nullptr)
+    throw std::runtime_error("Unknown crossover: " + crossoverName);
+  if (noThreads > 1 && factory.localSearchUsesGlobalRNG(
+                           factory.categoricalName(".Local.Search")))
+    throw std::runtime_error(
+        "MA.Threads > 1 requires ordered neighborhoods and no "
+        "random_best_improvement or adaptive local search");
+
+  MAWorkers workers{prob, factory, params, noThreads};
+  auto init = factory.buildInit();
+  eoInitPermutation<EOT> randomInit(N);
+
+  const auto tournament = [](const PopulationArena& population,
+                             eoRng& random) {
+    const int i = random.random(population.size());
+    const int j = random.random(population.size());
+    return population.fitness(i) <= population.fitness(j) ? i : j;
+  };
+
+  return runSearchExperiment(
+      prob,
+      [&](EOT& best) {
+        PopulationArena population(populationSize, N);
+        std::vector<EOT> children(
+            std::max<unsigned>(populationSize, noOffspring), EOT(N));
+
+        for (int i = 0; i < populationSize; i++) {
+          if (i == 0)
+            (*init)(children[i]);
+          else
+            randomInit(children[i]);
+        }
+        workers.run(populationSize, [&](unsigned w, unsigned i) {
+          if (children[i].invalid())
+            workers.workerProblem(w).eval()(children[i]);
+          (*workers.localSearches[w])(children[i]);
+        });
+        for (int i = 0; i < populationSize; i++)
+          population.store(i, children[i]);
+        population.load(population.best(), best);
+        prob.checkpoint().init(best);
+        prob.checkpointGlobal().init(best);
+
+        while (prob.checkpointGlobal()(best)) {
+          workers.run(noOffspring, [&](unsigned w, unsigned k) {
+            eoRng& random = RNG::paradiseo();
+            const int p1 = tournament(population, random);
+            const int p2 = tournament(population, random);
+            int a = random.random(N);
+            int b = random.random(N);
+            if (a > b)
+              std::swap(a, b);
+            EOT& child = children[k];
+            child.resize(N);
+            crossover(population[p1], population[p2], child.data(), N, a, b,
+                      workers.scratches[w]);
+            if (random.uniform() < mutationRate) {
+              FSPNeighbor shift(random.random(N), random.random(N), N);
+              shift.move(child);
+            }
+            child.invalidate();
+            workers.workerProblem(w).eval()(child);
+            (*workers.localSearches[w])(child);
+          });
+          for (unsigned k = 0; k < noOffspring; k++) {
+            const EOT& child = children[k];
+            const double fitness = child.fitness();
+            const int worst = population.worst();
+            if (fitness < population.fitness(worst) &&
+                !population.contains(child)) {
+              population.store(worst, child);
+              if (fitness < static_cast<double>(best.fitness()))
+                best = child;
+            }
+          }
+        }
+        prob.checkpoint().lastCall(best);
+        prob.checkpointGlobal().lastCall(best);
+      },
+      runOptions);
+}
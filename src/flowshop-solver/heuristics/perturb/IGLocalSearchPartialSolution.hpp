@@ -7,11 +7,13 @@
 #include <paradiseo/eo/eo>
 #include <paradiseo/mo/mo>
 
+#include "flowshop-solver/PermutationHash.hpp"
 #include "flowshop-solver/heuristics/perturb/DestructionConstruction.hpp"
 #include "flowshop-solver/heuristics/perturb/DestructionStrategy.hpp"
+#include "flowshop-solver/heuristics/perturb/PartialSolutionLocalSearch.hpp"
 
 template <class Ngh, class EOT = typename Ngh::EOT>
-class myResizableLocalSearch : public eoFunctorBase {
+class myResizableLocalSearch : public PartialSolutionLocalSearch<EOT> {
   moLocalSearch<Ngh>& localSearch;
   moIndexNeighborhood<Ngh>& neighborhood;
   std::function<int(int)> getMaxSize;
@@ -24,21 +26,21 @@ class myResizableLocalSearch : public eoFunctorBase {
         neighborhood{neighborhood},
         getMaxSize{std::move(getMaxSize)} {}
 
-  void operator()(EOT& sol){
+  auto operator()(EOT& sol) -> bool override {
     int size = sol.size();
     neighborhood.setNeighborhoodSize(getMaxSize(size));
-    localSearch(sol);
+    return localSearch(sol);
   }
 };
 
 template <class Ngh, class EOT = typename Ngh::EOT>
 class IGLocalSearchPartialSolution : public DestructionConstruction<Ngh> {
-  myResizableLocalSearch<Ngh>& localSearch;
+  PartialSolutionLocalSearch<EOT>& localSearch;
 
  public:
   IGLocalSearchPartialSolution(InsertionStrategy<Ngh>& insert,
                                DestructionStrategy<EOT>& destructionStrategy,
-                               myResizableLocalSearch<Ngh>& localSearch)
+                               PartialSolutionLocalSearch<EOT>& localSearch)
       : DestructionConstruction<Ngh>{insert, destructionStrategy},
         localSearch{localSearch} {}
 
@@ -46,11 +48,11 @@ class IGLocalSearchPartialSolution : public DestructionConstruction<Ngh> {
   using DestructionConstruction<Ngh>::construction;
 
   auto operator()(EOT& sol) -> bool override {
-    EOT before = sol;
+    const auto before = permutationHash(sol);
     EOT removedJobs = destruction(sol);
     if (sol.size() > 0)
       localSearch(sol);
     construction(sol, removedJobs);
-    return before != sol;
+    return before != permutationHash(sol);
   }
 };
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 #include <vector>
 
+#include "flowshop-solver/global.hpp"
+
 /**
  * the main algorithm of the local search
  */
@@ -28,7 +30,7 @@ class OpPerturbDestConst : public eoMonOp<EOT> {
     std::vector<int> D;
     EOT tmp;
     for (int k = 0; k < d; k++) {
-      int index = rng.random(sol.size());
+      int index = RNG::paradiseo().random(sol.size());
       D.push_back(sol[index]);
       sol.erase(sol.begin() + index);
     }
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/global.hpp"
+
+/**
+ * Local search applied to the partial solution left by a destruction step.
+ * Returns true if the partial solution was changed.
+ */
+template <class EOT>
+class PartialSolutionLocalSearch : public eoUF<EOT&, bool> {};
+
+/**
+ * Best insertion local search that works in place on a partial solution.
+ *
+ * Every pass removes each job (in random order) and reinserts it in the best
+ * position using the neighbor evaluation, so the head/tail tables of the
+ * Taillard acceleration are shared with the reconstruction step. No copy of
+ * the solution is made.
+ */
+template <class Ngh, class EOT = typename Ngh::EOT>
+class PartialInsertionLocalSearch : public PartialSolutionLocalSearch<EOT> {
+  moEval<Ngh>& neighborEval;
+  moNeighborComparator<Ngh>& neighborComparator;
+  moSolNeighborComparator<Ngh>& solNeighborComparator;
+  moContinuator<Ngh>& continuator;
+  const bool singleStep;
+  std::vector<int> jobs;
+
+ public:
+  PartialInsertionLocalSearch(moEval<Ngh>& neighborEval,
+                              moNeighborComparator<Ngh>& neighborComparator,
+                              moSolNeighborComparator<Ngh>& solNeighborComparator,
+                              moContinuator<Ngh>& continuator,
+                              bool singleStep = false)
+      : neighborEval{neighborEval},
+        neighborComparator{neighborComparator},
+        solNeighborComparator{solNeighborComparator},
+        continuator{continuator},
+        singleStep{singleStep} {}
+
+  auto operator()(EOT& sol) -> bool override {
+    const int n = static_cast<int>(sol.size());
+    if (n < 2)
+      return false;
+
+    Ngh neighbor, bestNeighbor;
+    // the identity move gives the fitness of the partial solution
+    neighbor.set(0, 0, n);
+    neighborEval(sol, neighbor);
+    sol.fitness(neighbor.fitness());
+
+    jobs.assign(sol.begin(), sol.end());
+    bool changed = false;
+    bool improve = true;
+    while (improve && continuator(sol)) {
+      improve = false;
+      std::shuffle(jobs.begin(), jobs.end(),
+                   ParadiseoRNGFunctor<unsigned int>());
+      for (const int job : jobs) {
+        const int insertPosition = static_cast<int>(
+            std::distance(sol.begin(), std::find(sol.begin(), sol.end(), job)));
+        bestNeighbor.invalidate();
+        for (int position = 0; position < n; position++) {
+          if (position == insertPosition)
+            continue;
+          neighbor.set(insertPosition, position, n);
+          neighbor.invalidate();
+          neighborEval(sol, neighbor);
+          if (bestNeighbor.invalid() ||
+              neighborComparator(bestNeighbor, neighbor)) {
+            bestNeighbor = neighbor;
+          }
+        }
+        if (solNeighborComparator(sol, bestNeighbor)) {
+          bestNeighbor.move(sol);
+          sol.fitness(bestNeighbor.fitness());
+          improve = changed = true;
+        }
+      }
+      if (singleStep)
+        break;
+    }
+    return changed;
+  }
+};
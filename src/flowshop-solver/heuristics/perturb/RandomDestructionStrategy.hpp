@@ -3,6 +3,7 @@
 #include <paradiseo/eo/eo>
 #include <paradiseo/mo/mo>
 
+#include "flowshop-solver/global.hpp"
 #include "flowshop-solver/heuristics/perturb/DestructionConstruction.hpp"
 #include "flowshop-solver/heuristics/perturb/DestructionStrategy.hpp"
 
@@ -19,7 +20,7 @@ class RandomDestructionStrategy : public DestructionStrategy<EOT> {
     EOT removed;
     int ds = std::min(destructionSize.value(), n);
     for (int k = 0; k < ds; k++) {
-      int index = rng.random(sol.size());
+      int index = RNG::paradiseo().random(sol.size());
       removed.push_back(sol[index]);
       sol.erase(sol.begin() + index);
     }
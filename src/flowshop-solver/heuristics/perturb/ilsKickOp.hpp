@@ -3,6 +3,7 @@
 #include <paradiseo/eo/eo>
 #include <paradiseo/mo/mo>
 
+#include "flowshop-solver/global.hpp"
 #include "flowshop-solver/number-of-swaps/NumberOfSwaps.hpp"
 
 template <class EOT>
@@ -21,13 +22,13 @@ class ilsKickOp : public eoMonOp<EOT> {
     unsigned i, j;
     for (unsigned int swap = 0; swap < numberOfSwaps.get(); swap++) {
       // generate two different indices
-      i = eo::rng.random(n);
+      i = RNG::paradiseo().random(n);
       j = (i + 1) % n;
       // swap
       std::swap(solution[i], solution[j]);
     }
-    i = eo::rng.random(n);
-    j = (i + eo::rng.random(std::max<int>(n / 5, 30))) % n;
+    i = RNG::paradiseo().random(n);
+    j = (i + RNG::paradiseo().random(std::max<int>(n / 5, 30))) % n;
     std::swap(solution[i], solution[j]);
     solution.invalidate();
     return true;
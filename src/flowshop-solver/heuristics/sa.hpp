@@ -1,10 +1,13 @@
 #pragma once
 
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 #include "flowshop-solver/MHParamsValues.hpp"
 #include "flowshop-solver/heuristics.hpp"
 #include "flowshop-solver/problems/Problem.hpp"
+#include "flowshop-solver/heuristics/FastSAexplorer.hpp"
 #include "flowshop-solver/heuristics/op_cooling_schedule.hpp"
 #include "flowshop-solver/MHParamsSpecsFactory.hpp"
 
@@ -86,8 +89,22 @@ auto solveWithSA(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
       break;
   }
 
-  moSA<Ngh> algo(neighborhood, fullEval, evalN, *cooling, *compSN,
-                 checkpointGlobal);
+  moSA<Ngh> algo0(neighborhood, fullEval, evalN, *cooling, *compSN,
+                  checkpointGlobal);
+
+  // cached temperatures and cheap acceptance tests
+  const bool fastSA = params.categoricalName("SA.Fast", "0") == "1";
+  if (fastSA && params.categorical("SA.Algo") == 1)
+    throw std::runtime_error(
+        "SA.Fast needs a cooling schedule independent of accepted moves");
+  const unsigned batchSize =
+      std::stoi(params.categoricalName("SA.Batch.Size", "1"));
+  TemperatureTable<EOT> temperatures(*cooling);
+  FastSAexplorer<Ngh> fastExplorer(neighborhood, evalN, *compSN, temperatures,
+                                   batchSize, &prob.continuator());
+  moLocalSearch<Ngh> algo1(fastExplorer, checkpointGlobal, fullEval);
+
+  moLocalSearch<Ngh>& algo = fastSA ? algo1 : algo0;
 
   return runExperiment(*init, algo, prob);
 }
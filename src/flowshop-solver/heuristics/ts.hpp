@@ -10,6 +10,7 @@
 #include "flowshop-solver/heuristics.hpp"
 #include "flowshop-solver/FSPProblemFactory.hpp"
 
+#include "flowshop-solver/heuristics/JobPositionTabuList.hpp"
 #include "flowshop-solver/heuristics/dummyAspiration.hpp"
 #include "flowshop-solver/heuristics/moFirstBestTS.hpp"
 #include "flowshop-solver/heuristics/moFirstTS.hpp"
@@ -91,6 +92,8 @@ auto solveWithTS(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
                                           params.integer("TS.How.Long.Taboo"));
   moSolVectorTabuList<Ngh> tabuList3(params.integer("TS.Max.Size.TL"),
                                      params.integer("TS.How.Long.Taboo"));
+  // job x position tenure matrix, O(1) checks
+  JobPositionTabuList<Ngh> tabuList4(params.integer("TS.How.Long.Taboo"));
   moTabuList<Ngh>* tabuList = nullptr;
   switch (params.categorical("TS.Tabu.List.Type")) {
     case 0:
@@ -105,6 +108,9 @@ auto solveWithTS(Problem<Ngh>& prob, const MHParamsValues& params) -> Result {
     case 3:
       tabuList = &tabuList3;
       break;
+    case 4:
+      tabuList = &tabuList4;
+      break;
     default:
       assert(false);
       break;
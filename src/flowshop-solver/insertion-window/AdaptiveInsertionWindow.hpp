@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "flowshop-solver/global.hpp"
+#include "flowshop-solver/insertion-window/InsertionWindow.hpp"
+
+/**
+ * Window around the current position whose half width follows the observed
+ * improvements. Every `epochSize` explorations the window grows when no
+ * improvement was found or an improvement was found close to its border,
+ * and otherwise shrinks to twice the largest improving distance.
+ */
+template <class EOT>
+class AdaptiveInsertionWindow : public InsertionWindow<EOT> {
+  const int minHalfWidth;
+  const int maxHalfWidth;
+  const int epochSize;
+  int halfWidth;
+  int noTries = 0;
+  int noImprovements = 0;
+  int maxImprovingDistance = 0;
+
+ public:
+  AdaptiveInsertionWindow(int initialHalfWidth,
+                          int minHalfWidth,
+                          int maxHalfWidth,
+                          int epochSize = 100)
+      : minHalfWidth(std::max(1, minHalfWidth)),
+        maxHalfWidth(std::max(this->minHalfWidth, maxHalfWidth)),
+        epochSize(epochSize),
+        halfWidth(clamp(initialHalfWidth, this->minHalfWidth,
+                        this->maxHalfWidth)) {}
+
+  [[nodiscard]] auto currentHalfWidth() const -> int { return halfWidth; }
+
+  void candidates(const EOT& sol,
+                  int position,
+                  std::vector<int>& positions) override {
+    const int n = static_cast<int>(sol.size());
+    this->fillRange(std::max(0, position - halfWidth),
+                    std::min(n - 1, position + halfWidth), positions);
+  }
+
+  void feedback(int distance, bool improved) override {
+    noTries++;
+    if (improved) {
+      noImprovements++;
+      maxImprovingDistance = std::max(maxImprovingDistance, distance);
+    }
+    if (noTries < epochSize)
+      return;
+    const bool atBorder = 4 * maxImprovingDistance >= 3 * halfWidth;
+    if (noImprovements == 0 || atBorder) {
+      halfWidth = std::min(maxHalfWidth, 2 * halfWidth);
+    } else {
+      halfWidth = std::max(minHalfWidth, 2 * maxImprovingDistance);
+    }
+    noTries = noImprovements = maxImprovingDistance = 0;
+  }
+};
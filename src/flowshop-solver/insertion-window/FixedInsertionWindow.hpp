@@ -0,0 +1,25 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "flowshop-solver/insertion-window/InsertionWindow.hpp"
+
+/**
+ * Positions at most `halfWidth` slots away from the current one.
+ */
+template <class EOT>
+class FixedInsertionWindow : public InsertionWindow<EOT> {
+  const int halfWidth;
+
+ public:
+  FixedInsertionWindow(int halfWidth) : halfWidth(halfWidth) {}
+
+  void candidates(const EOT& sol,
+                  int position,
+                  std::vector<int>& positions) override {
+    const int n = static_cast<int>(sol.size());
+    this->fillRange(std::max(0, position - halfWidth),
+                    std::min(n - 1, position + halfWidth), positions);
+  }
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <paradiseo/eo/eoFunctor.h>
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+/**
+ * Candidate positions evaluated when reinserting the job at `position` of a
+ * solution. The default implementation keeps the full insertion neighborhood.
+ */
+template <class EOT>
+class InsertionWindow : public eoFunctorBase {
+ public:
+  virtual void candidates(const EOT& sol,
+                          [[maybe_unused]] int position,
+                          std::vector<int>& positions) {
+    fillRange(0, static_cast<int>(sol.size()) - 1, positions);
+  }
+
+  /**
+   * Reports the distance between the job position and the best position
+   * found, and whether the move improved the solution.
+   */
+  virtual void feedback([[maybe_unused]] int distance,
+                        [[maybe_unused]] bool improved) {}
+
+ protected:
+  static void fillRange(int from, int to, std::vector<int>& positions) {
+    positions.resize(std::max(0, to - from + 1));
+    for (int i = from; i <= to; i++)
+      positions[i - from] = i;
+  }
+};
@@ -27,7 +27,12 @@ class AdaptiveNeighborhoodSize : public NeighborhoodSize {
 
   auto getSize() -> int override {
     if (rewards.available()) {
-      operatorSelection.feedback(rewards.reward(rewardType) * lastSelected);
+      // without a measured cost, smaller neighborhoods (larger partitions)
+      // are favored in proportion to their expected savings
+      const double reward = rewards.reward(rewardType);
+      operatorSelection.feedback(operatorSelection.chargesCost()
+                                     ? reward
+                                     : reward * lastSelected);
       operatorSelection.update();
     }
     int selected = operatorSelection.selectOperator();
@@ -22,11 +22,11 @@ class AdaptivePositionSelector : public PositionSelector<VecT> {
     const int k = operatorSelection.noOperators() - includeRandom;
     const int selected = operatorSelection.selectOperator();
     if (selected == 0) {
-      return rng.random(n);
+      return RNG::paradiseo().random(n);
     }
     const int roundCarry = selected == k && n % k > 0;
     const int pollSize = n / k + roundCarry;
-    return rng.random(pollSize) + (selected - 1) * (n / k);
+    return RNG::paradiseo().random(pollSize) + (selected - 1) * (n / k);
   }
 
   void feedback(const double reward) override {
@@ -65,6 +65,6 @@ class FSPFlowtimeEval : virtual public FSPEval {
   }
 
   [[nodiscard]] auto objective() const -> std::string override {
-    return "MAKESPAN";
+    return "FLOWTIME";
   }
 };
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cmath>
+#include <map>
+#include <string>
+
+#include "flowshop-solver/problems/FSPData.hpp"
+
+struct SampleMoments {
+  double sd = 0.0;
+  double skewness = 0.0;
+  double kurtosis = 0.0;
+};
+
+/** Sample sd, skewness g1 and excess kurtosis g2 of value(0..n-1). */
+template <class Value>
+auto sampleMoments(int n, Value value) -> SampleMoments {
+  double mean = 0.0;
+  for (int i = 0; i < n; i++)
+    mean += value(i);
+  mean /= n;
+  double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+  for (int i = 0; i < n; i++) {
+    const double d = value(i) - mean;
+    m2 += d * d;
+    m3 += d * d * d;
+    m4 += d * d * d * d;
+  }
+  SampleMoments result;
+  if (m2 == 0.0)
+    return result;
+  result.sd = n > 1 ? std::sqrt(m2 / (n - 1)) : 0.0;
+  m2 /= n;
+  m3 /= n;
+  m4 /= n;
+  result.skewness = m3 / std::pow(m2, 1.5);
+  result.kurtosis = m4 / (m2 * m2) - 3.0;
+  return result;
+}
+
+/**
+ * Features of the processing times of an instance, computed in O(nm) when it
+ * is loaded: the size, the sd of all the processing times and the mean sd,
+ * skewness and excess kurtosis of the processing times of each machine and
+ * of each job.
+ */
+inline auto instanceFeatures(const FSPData& data)
+    -> std::map<std::string, double> {
+  const int noJobs = data.noJobs();
+  const int noMachines = data.noMachines();
+  std::map<std::string, double> features;
+  features["no_jobs"] = noJobs;
+  features["no_machines"] = noMachines;
+  const auto& pts = data.procTimesRef();
+  features["pt_sd"] =
+      sampleMoments(noJobs * noMachines, [&](int i) { return pts[i]; }).sd;
+
+  auto addMeans = [&](const std::string& per, int n, int size, auto value) {
+    double sd = 0.0, skewness = 0.0, kurtosis = 0.0;
+    for (int i = 0; i < n; i++) {
+      const auto m = sampleMoments(size, [&](int k) { return value(i, k); });
+      sd += m.sd / n;
+      skewness += m.skewness / n;
+      kurtosis += m.kurtosis / n;
+    }
+    features["mean_sd_per_" + per] = sd;
+    features["mean_skew_per_" + per] = skewness;
+    features["mean_kurt_per_" + per] = kurtosis;
+  };
+  addMeans("machine", noMachines, noJobs,
+           [&](int m, int j) { return data.pt(j, m); });
+  addMeans("job", noJobs, noMachines,
+           [&](int j, int m) { return data.pt(j, m); });
+  return features;
+}
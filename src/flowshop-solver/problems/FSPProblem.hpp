@@ -80,6 +80,16 @@ struct FSPProblem : public Problem<FSPNeighbor> {
     reset();
   }
 
+  /**
+   * Problem on the same instance, objective and budget with its own
+   * evaluators, counters and checkpoints.
+   */
+  [[nodiscard]] auto clone() const -> std::unique_ptr<FSPProblem> {
+    return std::make_unique<FSPProblem>(_data, eval_func->type(),
+                                        eval_func->objective(), budget,
+                                        stopping_criterion, lower_bound);
+  }
+
   friend auto operator<<(std::ostream& o, const FSPProblem& d)
       -> std::ostream& {
     o << d.getData() << '\n'
@@ -136,15 +146,23 @@ struct FSPProblem : public Problem<FSPNeighbor> {
   auto bestSoFar() -> moBestSoFarStat<EOT>& override { return bestFoundGlobal; }
 
   [[nodiscard]] auto noEvals() const -> int override {
-    return static_cast<int>(
-        std::strtol(eval_counter.getValue().c_str(), nullptr, 10) +
-        std::strtol(eval_neighbor_counter.getValue().c_str(), nullptr, 10));
+    return static_cast<int>(evalCount());
+  }
+
+  [[nodiscard]] auto evalCount() const -> unsigned long override {
+    return eval_counter.value() + eval_neighbor_counter.value();
   }
 
   [[nodiscard]] auto getData() const -> const FSPData& {
     return eval_func->getData();
   }
 
+  [[nodiscard]] auto type() const -> std::string { return eval_func->type(); }
+
+  [[nodiscard]] auto objective() const -> std::string {
+    return eval_func->objective();
+  }
+
   [[nodiscard]] auto upperBound() const -> double override {
     return getData().maxCT();
   }
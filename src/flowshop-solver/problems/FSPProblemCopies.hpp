@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flowshop-solver/problems/FSPProblem.hpp"
+
+/**
+ * Copies of a problem used by concurrent workers. Each copy has its own
+ * evaluators, counters and checkpoints. sync() gives every copy the
+ * evaluation counts of the main problem before a parallel step, so their
+ * continuators see the shared budget, and merge() adds the evaluations spent
+ * by the copies back to the main problem.
+ */
+class FSPProblemCopies {
+  FSPProblem& problem;
+  std::vector<std::unique_ptr<FSPProblem>> copies;
+  unsigned long evals = 0;
+  unsigned long neighborEvals = 0;
+
+  static auto counterValue(const eoValueParam<unsigned long>& counter)
+      -> unsigned long {
+    return std::strtoul(counter.getValue().c_str(), nullptr, 10);
+  }
+
+  static void setCounterValue(eoValueParam<unsigned long>& counter,
+                              unsigned long value) {
+    counter.setValue(std::to_string(value));
+  }
+
+ public:
+  FSPProblemCopies(FSPProblem& problem, unsigned noCopies) : problem{problem} {
+    for (unsigned i = 0; i < noCopies; i++)
+      copies.push_back(problem.clone());
+  }
+
+  [[nodiscard]] auto size() const -> unsigned { return copies.size(); }
+
+  auto operator[](unsigned i) -> FSPProblem& { return *copies[i]; }
+
+  void sync() {
+    evals = counterValue(problem.eval_counter);
+    neighborEvals = counterValue(problem.eval_neighbor_counter);
+    for (auto& copy : copies) {
+      setCounterValue(copy->eval_counter, evals);
+      setCounterValue(copy->eval_neighbor_counter, neighborEvals);
+    }
+  }
+
+  void merge() {
+    auto totalEvals = evals;
+    auto totalNeighborEvals = neighborEvals;
+    for (auto& copy : copies) {
+      totalEvals += counterValue(copy->eval_counter) - evals;
+      totalNeighborEvals +=
+          counterValue(copy->eval_neighbor_counter) - neighborEvals;
+    }
+    setCounterValue(problem.eval_counter, totalEvals);
+    setCounterValue(problem.eval_neighbor_counter, totalNeighborEvals);
+  }
+};
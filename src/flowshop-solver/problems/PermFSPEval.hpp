@@ -8,6 +8,16 @@
 #include "flowshop-solver/problems/FSPData.hpp"
 #include "flowshop-solver/problems/FSPEval.hpp"
 
+/**
+ * Maximal run of consecutive positions `first..last` of the critical path
+ * processed on machine `machine`. Consecutive blocks share their corner job.
+ */
+struct CriticalBlock {
+  int machine;
+  int first;
+  int last;
+};
+
 class PermFSPCompiler {
   const FSPData& fspData;
   std::vector<int> part_ct;
@@ -85,6 +95,33 @@ class PermFSPCompiler {
     auto toCt = fromCt + _N;
     Ct.assign(fromCt, toCt);
   }
+
+  /**
+   * Extracts the critical blocks of `_fsp` from the completion times of the
+   * last call to compile, which must have been made with the same sequence.
+   * Blocks are returned in sequence order.
+   */
+  void criticalBlocks(const FSP& _fsp, std::vector<CriticalBlock>& blocks) const {
+    const int N = noJobs;
+    int j = fspData.noMachines() - 1;
+    int i = static_cast<int>(_fsp.size()) - 1;
+    blocks.clear();
+    blocks.push_back({j, i, i});
+    while (i > 0 || j > 0) {
+      // follow the predecessor that determined the start of operation (j, i)
+      const bool fromPrevJob =
+          j == 0 ||
+          (i > 0 && part_ct[j * N + i - 1] >= part_ct[(j - 1) * N + i]);
+      if (fromPrevJob) {
+        i--;
+        blocks.back().first = i;
+      } else {
+        j--;
+        blocks.push_back({j, i, i});
+      }
+    }
+    std::reverse(blocks.begin(), blocks.end());
+  }
 };
 
 class PermFSPEval : virtual public FSPEval {
@@ -26,6 +26,8 @@ struct Problem {
   [[nodiscard]] virtual auto size(int i = 0) const -> int = 0;
   [[nodiscard]] virtual auto upperBound() const -> double = 0;
   [[nodiscard]] virtual auto noEvals() const -> int = 0;
+  /** Solution plus neighbor evaluations, read from the counters. */
+  [[nodiscard]] virtual auto evalCount() const -> unsigned long = 0;
   [[nodiscard]] virtual auto getNeighborhoodSize(int size) const -> int = 0;
 
   [[nodiscard]] auto maxNeighborhoodSize() const -> int {
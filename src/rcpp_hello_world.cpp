@@ -4,6 +4,7 @@ using namespace Rcpp;
 #include "MHParamsSpecsFactory.hpp"
 #include "FSPProblemFactory.hpp"
 #include "fla_methods.hpp"
+#include "heuristics/FSPBranchAndBound.hpp"
 #include "heuristics/all.hpp"
 #include "heuristics.hpp"
 #include "fla/LocalOptimaNetwork.hpp"
@@ -169,6 +170,66 @@ std::vector<double> enumerateAllFitness(Rcpp::CharacterVector rproblem)
   return enumerateAll(prob_data);
 }
 
+// [[Rcpp::export]]
+DataFrame enumerateAllFitnessHistogram(Rcpp::CharacterVector rproblem, int threads)
+{
+  auto prob_data = rcharVec2map(rproblem);
+  auto counts = enumerateAllHistogram(prob_data, threads);
+  NumericVector fitness;
+  NumericVector count;
+  for (const auto& bin : counts) {
+    fitness.push_back(bin.first);
+    count.push_back(bin.second);
+  }
+  return DataFrame::create(Named("fitness") = fitness, Named("count") = count);
+}
+
+// [[Rcpp::export]]
+double enumerateAllFitnessToFile(Rcpp::CharacterVector rproblem, std::string filename, int threads)
+{
+  auto prob_data = rcharVec2map(rproblem);
+  return enumerateAllToFile(prob_data, filename, threads);
+}
+
+// [[Rcpp::export]]
+NumericVector readFitnessFileValues(std::string filename)
+{
+  std::vector<double> values;
+  readFitnessFile(filename, [&](long value) { values.push_back(value); });
+  return wrap(values);
+}
+
+// [[Rcpp::export]]
+DataFrame readAOSTraceEvents(std::string filename)
+{
+  std::vector<double> time, reward, fitness;
+  std::vector<int> arm;
+  readAOSTrace(filename, [&](const AOSTraceEvent& event) {
+    time.push_back(event.time * 1e-6);
+    arm.push_back(event.arm);
+    reward.push_back(event.reward);
+    fitness.push_back(event.fitness);
+  });
+  return DataFrame::create(Named("time") = time, Named("arm") = arm,
+                           Named("reward") = reward,
+                           Named("fitness") = fitness);
+}
+
+// [[Rcpp::export]]
+NumericVector fspInstanceFeatures(std::string filename)
+{
+  const auto features = instanceFeatures(FSPData(filename));
+  NumericVector values(features.size());
+  CharacterVector names(features.size());
+  int i = 0;
+  for (const auto& [name, value] : features) {
+    names[i] = name;
+    values[i++] = value;
+  }
+  values.names() = names;
+  return values;
+}
+
 template<class EOT>
 std::vector<int> solToVec(const EOT& sol) {
   std::vector<int> vec(sol.size());
@@ -203,6 +264,37 @@ List enumerateSolutions(Rcpp::List fspInstance, Rcpp::CharacterVector fspProblem
   );
 }
 
+// [[Rcpp::export]]
+List enumerateNearOptimalSolutions(Rcpp::List fspInstance,
+                                   Rcpp::CharacterVector fspProblem,
+                                   long tolerance,
+                                   int threads) {
+  std::vector<int> pts =  Rcpp::as<std::vector<int>>(fspInstance["pt"]);
+  int no_jobs = fspInstance["no_jobs"];
+  FSPData dt(pts, no_jobs);
+  auto prob_data = rcharVec2map(fspProblem);
+  if (prob_data["fsp_type"] != "PERM")
+    Rcpp::stop("branch and bound is only available for PERM problems");
+  FSPBranchAndBound bnb(dt, prob_data["objective"]);
+  // the callback may run on worker threads, so R objects are only built
+  // after the search
+  std::vector<std::vector<int>> solutions;
+  std::vector<long> fitness;
+  auto result = bnb.solve(
+      tolerance,
+      [&](const std::vector<int>& perm, long value) {
+        solutions.push_back(perm);
+        fitness.push_back(value);
+      },
+      threads);
+  return List::create(
+    Named("optimum") = result.optimum,
+    Named("solutions") = solutions,
+    Named("fitness") = NumericVector(fitness.begin(), fitness.end()),
+    Named("no_nodes") = static_cast<double>(result.noNodes)
+  );
+}
+
 inline auto buildLONSampling(const std::string& name) -> std::unique_ptr<LONSampling> {
   if (name == "snowball")
     return std::make_unique<SnowballLONSampling>();
@@ -0,0 +1,76 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/global.hpp"
+#include "flowshop-solver/heuristics/IGexplorer.hpp"
+#include "flowshop-solver/problems/FSPData.hpp"
+#include "flowshop-solver/problems/PermFSPEval.hpp"
+#include "flowshop-solver/problems/PermFSPNeighborMakespanEval.hpp"
+
+/**
+ * Compares the full evaluation and the neighbor evaluation versions of
+ * IGexplorer on a Taillard 100x20 instance.
+ *
+ * usage: bench-igexplorer [passes] [instance file]
+ */
+
+auto loadInstance(const std::string& path) -> FSPData {
+  if (std::ifstream(path).good())
+    return FSPData(path);
+  std::cerr << path << " not found, using a random 100x20 instance\n";
+  return FSPData(100, 20, 99);
+}
+
+template <class Explorer>
+auto runPasses(Explorer& explorer, FSP sol, int passes) -> FSP {
+  explorer.initParam(sol);
+  for (int i = 0; i < passes * static_cast<int>(sol.size()); i++) {
+    explorer(sol);
+    explorer.updateParam(sol);
+  }
+  return sol;
+}
+
+auto main(int argc, char* argv[]) -> int {
+  const int passes = argc > 1 ? std::atoi(argv[1]) : 3;
+  const std::string instance =
+      argc > 2 ? argv[2] : DATA_FOLDER "/instances/taillard/tai100_20_1.txt";
+
+  FSPData data = loadInstance(instance);
+  PermFSPMakespanEval fullEval(data);
+  PermFSPNeighborMakespanEval neighborEval(data);
+  moSolComparator<FSP> comparator;
+  FullEvalIGexplorer<FSPNeighbor> fullEvalExplorer(fullEval, data.noJobs(),
+                                                   comparator);
+  IGexplorer<FSPNeighbor> explorer(neighborEval, data.noJobs(), comparator);
+
+  RNG::seed(42);
+  FSP sol(data.noJobs());
+  eoInitPermutation<FSP> init(data.noJobs());
+  init(sol);
+  fullEval(sol);
+
+  FSP fullEvalSol, neighborEvalSol;
+  RNG::seed(42);
+  const auto fullEvalTime = Measure<>::execution(
+      [&]() { fullEvalSol = runPasses(fullEvalExplorer, sol, passes); });
+  RNG::seed(42);
+  const auto neighborEvalTime = Measure<>::execution(
+      [&]() { neighborEvalSol = runPasses(explorer, sol, passes); });
+
+  std::cout << "explorer,time_ms,fitness\n"
+            << "full_eval," << fullEvalTime << ',' << fullEvalSol.fitness()
+            << '\n'
+            << "neighbor_eval," << neighborEvalTime << ','
+            << neighborEvalSol.fitness() << '\n';
+  if (fullEvalSol != neighborEvalSol) {
+    std::cerr << "explorers reached different solutions\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "flowshop-solver/aos/beta_distribution.hpp"
+#include "flowshop-solver/aos/thompson_sampling.hpp"
+#include "flowshop-solver/global.hpp"
+
+/**
+ * Compares the selection of ThompsonSampling with the previous one, which
+ * built a beta_distribution (two std::gamma_distribution) per operator and
+ * step, on Bernoulli bandits with 3, 50 and 500 operators.
+ *
+ * usage: bench-thompson-sampling [steps]
+ */
+
+template <class OpT>
+class BetaDistributionThompsonSampling : public ThompsonSampling<OpT> {
+  using ThompsonSampling<OpT>::alphas;
+  using ThompsonSampling<OpT>::betas;
+  using ThompsonSampling<OpT>::noSamples;
+  using ThompsonSampling<OpT>::opIdx;
+  using ThompsonSampling<OpT>::noOperators;
+
+ protected:
+  auto selectOperatorIdx() -> int override {
+    opIdx            = 0;
+    double maxSample = 0.0;
+    for (int i = 0; i < noOperators(); i++) {
+      beta_distribution<double> dist(alphas[i], betas[i]);
+      double                    meanSample = 0;
+      for (int j = 0; j < noSamples; j++) {
+        meanSample += dist(RNG::localEngine()) / noSamples;
+      }
+      if (meanSample > maxSample) {
+        opIdx     = i;
+        maxSample = meanSample;
+      }
+    }
+    return opIdx;
+  }
+
+ public:
+  using ThompsonSampling<OpT>::ThompsonSampling;
+};
+
+/** Runs the bandit, returns the fraction of the last half on the best arm. */
+auto runBandit(OperatorSelection<int>& aos, int arms, int steps) -> double {
+  std::mt19937 rewards(7);
+  std::uniform_real_distribution<double> uniform;
+  int best = 0;
+  for (int step = 0; step < steps; step++) {
+    const int arm = aos.selectOperator();
+    // success probability grows with the arm index
+    aos.feedback(uniform(rewards) < (arm + 1.0) / (arms + 1.0));
+    aos.update();
+    if (step >= steps / 2 && arm == arms - 1)
+      best++;
+  }
+  return best / (steps - steps / 2.0);
+}
+
+auto main(int argc, char* argv[]) -> int {
+  const int steps = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+  std::cout << "arms,implementation,time_ms,best_arm_rate\n";
+  for (int arms : {3, 50, 500}) {
+    std::vector<int> operators(arms);
+    std::iota(operators.begin(), operators.end(), 0);
+    BetaDistributionThompsonSampling<int> reference(operators);
+    ThompsonSampling<int> batched(operators);
+
+    double referenceRate = 0.0, batchedRate = 0.0;
+    RNG::seed(42);
+    const auto referenceTime = Measure<>::execution(
+        [&]() { referenceRate = runBandit(reference, arms, steps); });
+    RNG::seed(42);
+    const auto batchedTime = Measure<>::execution(
+        [&]() { batchedRate = runBandit(batched, arms, steps); });
+
+    std::cout << arms << ",beta_distribution," << referenceTime << ','
+              << referenceRate << '\n'
+              << arms << ",batched," << batchedTime << ',' << batchedRate
+              << '\n';
+  }
+  return 0;
+}
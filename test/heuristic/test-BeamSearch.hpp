@@ -0,0 +1,42 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+#include "flowshop-solver/heuristics/BeamSearch.hpp"
+#include "flowshop-solver/heuristics/FSPOrderHeuristics.hpp"
+#include "flowshop-solver/problems/FSPData.hpp"
+#include "flowshop-solver/problems/FSPProblem.hpp"
+
+TEST(BeamSearch, BuildsEvaluatedPermutations) {
+  rng.reseed(65465l);
+  const int no_jobs = 20;
+  FSPData dt(no_jobs, 5, 99);
+  for (const std::string type : {"PERM", "NOWAIT"}) {
+    for (const std::string objective : {"MAKESPAN", "FLOWTIME"}) {
+      FSPProblem prob(dt, type, objective, "low", "TIME");
+      auto order = buildPriority(dt, "sum_pij", false, "decr");
+      FSP sequential;
+      BeamSearchInit beam(prob, *order, 4);
+      beam(sequential);
+
+      FSP ref(no_jobs);
+      std::iota(ref.begin(), ref.end(), 0);
+      ASSERT_TRUE(std::is_permutation(sequential.begin(), sequential.end(),
+                                      ref.begin()));
+      FSP evaluated = sequential;
+      evaluated.invalidate();
+      prob.eval()(evaluated);
+      ASSERT_EQ(evaluated.fitness(), sequential.fitness());
+
+      FSP threaded;
+      BeamSearchInit threadedBeam(prob, *order, 4, 3);
+      threadedBeam(threaded);
+      ASSERT_TRUE(std::equal(sequential.begin(), sequential.end(),
+                             threaded.begin(), threaded.end()));
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flowshop-solver/heuristics/FSPBranchAndBound.hpp"
+#include "flowshop-solver/problems/FSPData.hpp"
+#include "flowshop-solver/problems/PermFSPEval.hpp"
+
+TEST(FSPBranchAndBound, MatchesEnumeration) {
+  rng.reseed(65465l);
+  const int no_jobs = 7;
+  FSPData dt(no_jobs, 4, 20);
+  PermFSPMakespanEval makespanEval(dt);
+  PermFSPFlowtimeEval flowtimeEval(dt);
+
+  const std::vector<std::pair<std::string, FSPEval*>> evals = {
+      {"MAKESPAN", &makespanEval}, {"FLOWTIME", &flowtimeEval}};
+  for (const auto& [objective, eval] : evals) {
+    const long tolerance = 3;
+    std::vector<long> fitness;
+    FSP sol(no_jobs);
+    std::iota(sol.begin(), sol.end(), 0);
+    do {
+      sol.invalidate();
+      (*eval)(sol);
+      fitness.push_back(static_cast<long>(sol.fitness()));
+    } while (std::next_permutation(sol.begin(), sol.end()));
+    const long optimum = *std::min_element(fitness.begin(), fitness.end());
+    const auto noNearOptimal =
+        std::count_if(fitness.begin(), fitness.end(),
+                      [&](long f) { return f <= optimum + tolerance; });
+
+    FSPBranchAndBound bnb(dt, objective);
+    for (unsigned noThreads : {1u, 3u}) {
+      long streamed = 0;
+      const auto result = bnb.solve(
+          tolerance,
+          [&](const std::vector<int>& perm, long value) {
+            FSP s(no_jobs);
+            s.assign(perm.begin(), perm.end());
+            (*eval)(s);
+            ASSERT_EQ(value, static_cast<long>(s.fitness()));
+            ASSERT_LE(value, optimum + tolerance);
+            streamed++;
+          },
+          noThreads);
+      ASSERT_EQ(optimum, result.optimum);
+      ASSERT_EQ(optimum, bnb.evaluate(result.solution));
+      ASSERT_EQ(noNearOptimal, streamed);
+    }
+    const auto ignore = [](const std::vector<int>&, long) {};
+    ASSERT_EQ(bnb.enumerate(optimum + tolerance, ignore, 1),
+              bnb.enumerate(optimum + tolerance, ignore, 3));
+  }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flowshop-solver/heuristics/PermutationCrossover.hpp"
+#include "flowshop-solver/heuristics/all.hpp"
+#include "flowshop-solver/heuristics/PopulationArena.hpp"
+#include "flowshop-solver/problems/FSP.hpp"
+
+TEST(PermutationCrossover, OrderCrossover) {
+  const std::vector<int> p1 = {0, 1, 2, 3, 4, 5, 6, 7};
+  const std::vector<int> p2 = {7, 3, 1, 6, 0, 5, 2, 4};
+  std::vector<int> child(8);
+  CrossoverScratch scratch;
+  orderCrossover(p1.data(), p2.data(), child.data(), 8, 2, 4, scratch);
+  // keeps 2 3 4, then fills from position 5 with p2 from position 5
+  ASSERT_EQ(std::vector<int>({6, 0, 2, 3, 4, 5, 7, 1}), child);
+}
+
+TEST(PermutationCrossover, PartiallyMappedCrossover) {
+  const std::vector<int> p1 = {0, 1, 2, 3, 4, 5, 6, 7};
+  const std::vector<int> p2 = {7, 3, 1, 6, 0, 5, 2, 4};
+  std::vector<int> child(8);
+  CrossoverScratch scratch;
+  partiallyMappedCrossover(p1.data(), p2.data(), child.data(), 8, 2, 4,
+                           scratch);
+  // 3 and 4 are in the segment, mapped to 6 and 0
+  ASSERT_EQ(std::vector<int>({7, 6, 2, 3, 4, 5, 1, 0}), child);
+}
+
+TEST(PermutationCrossover, ChildrenArePermutations) {
+  const int n = 20;
+  std::vector<int> p1(n), p2(n), child(n);
+  std::iota(p1.begin(), p1.end(), 0);
+  std::iota(p2.begin(), p2.end(), 0);
+  std::reverse(p2.begin(), p2.end());
+  std::rotate(p2.begin(), p2.begin() + 7, p2.end());
+  CrossoverScratch scratch;
+  for (const auto crossover : {permutationCrossover("ox"),
+                               permutationCrossover("pmx")}) {
+    for (int a = 0; a < n; a++) {
+      for (int b = a; b < n; b++) {
+        crossover(p1.data(), p2.data(), child.data(), n, a, b, scratch);
+        ASSERT_TRUE(std::is_permutation(child.begin(), child.end(),
+                                        p1.begin()));
+      }
+    }
+  }
+}
+
+TEST(PopulationArena, StoreAndLoad) {
+  PopulationArena population(3, 4);
+  FSP sol(4);
+  std::iota(sol.begin(), sol.end(), 0);
+  for (int i = 0; i < 3; i++) {
+    std::rotate(sol.begin(), sol.begin() + 1, sol.end());
+    sol.fitness(10 - i);
+    population.store(i, sol);
+  }
+  ASSERT_EQ(2, population.best());
+  ASSERT_EQ(0, population.worst());
+  FSP loaded;
+  population.load(0, loaded);
+  ASSERT_EQ(std::vector<int>({1, 2, 3, 0}),
+            std::vector<int>(loaded.begin(), loaded.end()));
+  ASSERT_EQ(10, loaded.fitness());
+  ASSERT_TRUE(population.contains(sol));
+  sol.fitness(11);
+  ASSERT_FALSE(population.contains(sol));
+}
+
+TEST(Solve, MAWithCriticalBlockInsertion) {
+  std::unordered_map<std::string, std::string> prob;
+  prob["problem"] = "flowshop";
+  prob["type"] = "PERM";
+  prob["objective"] = "MAKESPAN";
+  prob["budget"] = "low";
+  prob["stopping_criterion"] = "EVALS";
+  prob["instance"] = "exponential_random_10_5_04.txt";
+  std::unordered_map<std::string, std::string> params;
+  params["MA.Init"] = "random";
+  params["MA.Comp.Strat"] = "strict";
+  params["MA.Neighborhood.Size"] = "1.0";
+  params["MA.Neighborhood.Strat"] = "ordered";
+  params["MA.Local.Search"] = "critical_block_insertion";
+  params["MA.LS.Single.Step"] = "0";
+  params["MA.Population.Size"] = "10";
+  params["MA.Crossover"] = "ox";
+  params["MA.Mutation.Rate"] = "0.2";
+  params["MA.Offspring"] = "2";
+  params["MA.Threads"] = "1";
+
+  RNG::seed(65465l);
+  RunOptions ro;
+  ro.printBestFitness = false;
+  const Result result = solveWith("MA", prob, params, ro);
+  ASSERT_GT(result.fitness, 0);
+  ASSERT_GT(result.no_evals, 0);
+
+  prob["objective"] = "FLOWTIME";
+  ASSERT_THROW(solveWith("MA", prob, params, ro), std::runtime_error);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/heuristics/FastSAexplorer.hpp"
+#include "flowshop-solver/heuristics/op_cooling_schedule.hpp"
+#include "flowshop-solver/problems/FSP.hpp"
+#include "flowshop-solver/problems/FSPData.hpp"
+#include "flowshop-solver/problems/PermFSPEval.hpp"
+#include "flowshop-solver/problems/PermFSPNeighborMakespanEval.hpp"
+
+namespace {
+
+/** Stops once `max` neighbors have been evaluated. */
+struct NeighborBudget : public moContinuator<FSPNeighbor> {
+  moEvalCounter<FSPNeighbor>& counter;
+  unsigned long max;
+  NeighborBudget(moEvalCounter<FSPNeighbor>& counter, unsigned long max)
+      : counter{counter}, max{max} {}
+  void init(FSP&) override {}
+  auto operator()(FSP&) -> bool override { return counter.value() < max; }
+};
+
+}  // namespace
+
+TEST(TemperatureTable, MatchesCoolingSchedule) {
+  FSP sol(5);
+  opCoolingSchedule<FSP> cooling(10.0, 0.5, 0.01);
+  opCoolingSchedule<FSP> reference(10.0, 0.5, 0.01);
+  // small cache so that later iterations are computed on the fly
+  TemperatureTable<FSP> temperatures(cooling, 50);
+  temperatures.init(sol);
+
+  double temperature = reference.init(sol);
+  unsigned long k = 0;
+  for (; reference(temperature); k++) {
+    ASSERT_TRUE(temperatures.isContinue(k));
+    ASSERT_DOUBLE_EQ(temperature, temperatures[k]);
+    reference.update(temperature, false);
+  }
+  ASSERT_FALSE(temperatures.isContinue(k));
+  ASSERT_EQ(50u, temperatures.cachedSize());
+
+  // restarting past the cached iterations replays the schedule
+  temperature = reference.init(sol);
+  for (int i = 0; i < 120; i++)
+    reference.update(temperature, false);
+  ASSERT_TRUE(temperatures.isContinue(120));
+  ASSERT_DOUBLE_EQ(temperature, temperatures[120]);
+}
+
+TEST(FastSAexplorer, AcceptsAsSAexplorer) {
+  rng.reseed(1234l);
+  const int N = 20;
+  FSPData fspData(N, 5, 100);
+  PermFSPMakespanEval fullEval(fspData);
+  PermFSPNeighborMakespanEval neighborEval(fspData);
+  moRndWithoutReplNeighborhood<FSPNeighbor> neighborhood((N - 1) * (N - 1));
+  moSolNeighborComparator<FSPNeighbor> compSN;
+  moTrueContinuator<FSPNeighbor> continuator;
+
+  FSP sol(N);
+  eoInitPermutation<FSP> init(N);
+  init(sol);
+  fullEval(sol);
+  FSP fastSol = sol;
+
+  moSimpleCoolingSchedule<FSP> cooling(50.0, 0.9, 20, 0.5);
+  moEvalCounter<FSPNeighbor> counter(neighborEval);
+  moSA<FSPNeighbor> sa(neighborhood, fullEval, counter, cooling, compSN,
+                       continuator);
+  rng.reseed(42l);
+  sa(sol);
+
+  moSimpleCoolingSchedule<FSP> fastCooling(50.0, 0.9, 20, 0.5);
+  TemperatureTable<FSP> temperatures(fastCooling);
+  moEvalCounter<FSPNeighbor> fastCounter(neighborEval);
+  FastSAexplorer<FSPNeighbor> explorer(neighborhood, fastCounter, compSN,
+                                       temperatures);
+  moLocalSearch<FSPNeighbor> fastSA(explorer, continuator, fullEval);
+  rng.reseed(42l);
+  fastSA(fastSol);
+
+  ASSERT_EQ(counter.value(), fastCounter.value());
+  ASSERT_EQ(sol.fitness(), fastSol.fitness());
+  ASSERT_TRUE(std::equal(sol.begin(), sol.end(), fastSol.begin()));
+}
+
+TEST(FastSAexplorer, BatchStopsAtBudget) {
+  rng.reseed(1234l);
+  const int N = 20;
+  FSPData fspData(N, 5, 100);
+  PermFSPMakespanEval fullEval(fspData);
+  PermFSPNeighborMakespanEval neighborEval(fspData);
+  moRndWithoutReplNeighborhood<FSPNeighbor> neighborhood((N - 1) * (N - 1));
+  moSolNeighborComparator<FSPNeighbor> compSN;
+
+  FSP sol(N);
+  eoInitPermutation<FSP> init(N);
+  init(sol);
+  fullEval(sol);
+
+  // cold schedule, so that most batches run to their end
+  opCoolingSchedule<FSP> cooling(0.01, 0.001, 0.01);
+  TemperatureTable<FSP> temperatures(cooling);
+  moEvalCounter<FSPNeighbor> counter(neighborEval);
+  NeighborBudget budget(counter, 1000);
+  FastSAexplorer<FSPNeighbor> explorer(neighborhood, counter, compSN,
+                                       temperatures, 64, &budget);
+  moLocalSearch<FSPNeighbor> search(explorer, budget, fullEval);
+  search(sol);
+
+  ASSERT_EQ(1000ul, counter.value());
+}
@@ -1,13 +1,18 @@
 #pragma once
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <unordered_map>
+#include <vector>
 
 #include "flowshop-solver/FSPProblemFactory.hpp"
 #include "flowshop-solver/MHParamsSpecs.hpp"
 #include "flowshop-solver/MHParamsSpecsFactory.hpp"
 #include "flowshop-solver/MHParamsValues.hpp"
 #include "flowshop-solver/eoFSPFactory.hpp"
+#include "flowshop-solver/heuristics/VisitedSolutionsFilter.hpp"
 #include "flowshop-solver/heuristics/all.hpp"
 #include "flowshop-solver/problems/FSPProblem.hpp"
 
@@ -165,3 +170,163 @@ TEST(SolveFullAdapt, IG) {
      ASSERT_TRUE(result.no_evals > 0);
      ASSERT_TRUE(result.time > 0); */
 }
+
+TEST(Solve, ThreadedIGBPSavesAOSState) {
+  std::unordered_map<std::string, std::string> prob;
+  prob["problem"] = "flowshop";
+  prob["type"] = "PERM";
+  prob["objective"] = "MAKESPAN";
+  prob["budget"] = "low";
+  prob["stopping_criterion"] = "EVALS";
+  prob["instance"] = "exponential_random_10_5_04.txt";
+  std::unordered_map<std::string, std::string> params;
+  params["IGBP.Init"] = "random";
+  params["IGBP.Comp.Strat"] = "strict";
+  params["IGBP.Neighborhood.Size"] = "1.0";
+  params["IGBP.Neighborhood.Strat"] = "ordered";
+  params["IGBP.Local.Search"] = "first_improvement";
+  params["IGBP.LS.Single.Step"] = "0";
+  params["IGBP.Threads"] = "3";
+  params["IGBP.Accept"] = "temperature";
+  params["IGBP.Accept.Temperature"] = "0.5";
+  params["IGBP.Perturb"] = "rs";
+  params["IGBP.Perturb.DestructionSize"] = "4";
+  params["IGBP.Perturb.DestructionSizeStrategy"] = "fixed";
+  params["IGBP.Perturb.Insertion"] = "first_best";
+  params["IGBP.DestructionStrategy"] = "adaptive_position";
+  params["IGBP.AdaptivePosition.Replace"] = "yes";
+  params["IGBP.AdaptivePosition.NoArms"] = "fixed_3";
+  params["IGBP.AdaptivePosition.RandomArm"] = "no";
+  params["IGBP.AdaptivePosition.RewardType"] = "0";
+  params["IGBP.AdaptivePosition.AOS.WarmUp"] = "0";
+  params["IGBP.AdaptivePosition.AOS.WarmUp.Strategy"] = "random";
+  params["IGBP.AdaptivePosition.AOS.RewardType"] = "0";
+  params["IGBP.AdaptivePosition.AOS.Cost"] = "none";
+  params["IGBP.AdaptivePosition.AOS.Strategy"] = "thompson_sampling";
+  params["IGBP.AdaptivePosition.AOS.TS.Strategy"] = "static";
+  params["IGBP.AOS.RewardType"] = "0";
+
+  const std::string filename = "test-igbp-aos-state.txt";
+  std::remove(filename.c_str());
+  RNG::seed(65465l);
+  RunOptions ro;
+  ro.printBestFitness = false;
+  ro.aosState = filename;
+  const Result result = solveWith("IGBP", prob, params, ro);
+  ASSERT_GT(result.fitness, 0);
+
+  // the branch factories are gone, but their position selections are saved
+  std::ifstream in(filename);
+  std::string line;
+  int noStates = 0;
+  while (std::getline(in, line))
+    if (line.find("IGBP.AdaptivePosition/thompson_sampling") !=
+        std::string::npos)
+      noStates++;
+  EXPECT_GT(noStates, 0);
+  std::remove(filename.c_str());
+  std::remove((filename + ".lock").c_str());
+}
+
+TEST(VisitedSolutionsTable, CountsHits) {
+  VisitedSolutionsTable table(16);
+  FSP a, b;
+  a.assign({0, 1, 2, 3});
+  b.assign({1, 0, 2, 3});
+  ASSERT_NE(permutationHash(a), permutationHash(b));
+  ASSERT_FALSE(table.visited(permutationHash(a)));
+  ASSERT_TRUE(table.visited(permutationHash(a)));
+  ASSERT_FALSE(table.visited(permutationHash(b)));
+  ASSERT_EQ(table.lookups(), 3);
+  ASSERT_EQ(table.hits(), 1);
+}
+
+TEST(VisitedSolutionsTable, EvictsHomeSlotWhenProbesAreFull) {
+  VisitedSolutionsTable table(16);
+  ASSERT_EQ(table.capacity(), 16u);
+  // all these hashes share the home slot 0
+  for (uint64_t h = 1; h <= 8; h++)
+    ASSERT_FALSE(table.visited(h << 4u));
+  for (uint64_t h = 1; h <= 8; h++)
+    ASSERT_TRUE(table.visited(h << 4u));
+  // the probes are full: 9 replaces 1 in the home slot
+  ASSERT_FALSE(table.visited(9u << 4u));
+  ASSERT_TRUE(table.visited(9u << 4u));
+  ASSERT_FALSE(table.visited(1u << 4u));
+  ASSERT_TRUE(table.visited(2u << 4u));
+  ASSERT_EQ(table.lookups(), 20);
+  ASSERT_EQ(table.hits(), 10);
+}
+
+namespace {
+
+/** Explorer of a local search that does not use it. */
+struct UnusedExplorer : public moNeighborhoodExplorer<FSPNeighbor> {
+  void initParam(FSP&) override {}
+  void updateParam(FSP&) override {}
+  auto isContinue(FSP&) -> bool override { return false; }
+  void move(FSP&) override {}
+  auto accept(FSP&) -> bool override { return false; }
+  void terminate(FSP&) override {}
+  void operator()(FSP&) override {}
+};
+
+/** Evaluates a permutation by its first job. */
+struct FirstJobFitness : public eoEvalFunc<FSP> {
+  void operator()(FSP& sol) override { sol.fitness(sol[0]); }
+};
+
+/** Local search that sorts the jobs and counts its calls. */
+struct SortingLocalSearch : public moLocalSearch<FSPNeighbor> {
+  eoEvalFunc<FSP>& eval;
+  int calls = 0;
+  SortingLocalSearch(moNeighborhoodExplorer<FSPNeighbor>& explorer,
+                     moContinuator<FSPNeighbor>& continuator,
+                     eoEvalFunc<FSP>& eval)
+      : moLocalSearch<FSPNeighbor>(explorer, continuator, eval), eval{eval} {}
+  auto operator()(FSP& sol) -> bool override {
+    calls++;
+    std::sort(sol.begin(), sol.end());
+    eval(sol);
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(VisitedFilterLocalSearch, ReturnsCachedLocalOptimum) {
+  UnusedExplorer explorer;
+  moTrueContinuator<FSPNeighbor> continuator;
+  FirstJobFitness eval;
+  SortingLocalSearch localSearch(explorer, continuator, eval);
+  VisitedSolutionsTable table(64);
+  VisitedFilterLocalSearch<FSPNeighbor> filter(localSearch, table, continuator,
+                                               eval);
+  const std::vector<int> optimum = {0, 1, 2, 3};
+
+  FSP sol;
+  sol.assign({2, 0, 3, 1});
+  const FSP start = sol;
+  filter(sol);
+  ASSERT_EQ(1, localSearch.calls);
+
+  // visited start: the local optimum is returned without searching
+  sol = start;
+  filter(sol);
+  ASSERT_EQ(1, localSearch.calls);
+  ASSERT_EQ(optimum, std::vector<int>(sol.begin(), sol.end()));
+  ASSERT_FALSE(sol.invalid());
+  ASSERT_EQ(0, sol.fitness());
+
+  // only starts are cached, so the local optimum itself is searched
+  filter(sol);
+  ASSERT_EQ(2, localSearch.calls);
+  ASSERT_EQ(optimum, std::vector<int>(sol.begin(), sol.end()));
+
+  sol.assign({3, 2, 1, 0});
+  sol.invalidate();
+  filter(sol);
+  ASSERT_EQ(3, localSearch.calls);
+  ASSERT_EQ(table.lookups(), 4);
+  ASSERT_EQ(table.hits(), 1);
+}
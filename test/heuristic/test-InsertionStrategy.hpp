@@ -1,7 +1,37 @@
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "flowshop-solver/insertion-window/AdaptiveInsertionWindow.hpp"
+#include "flowshop-solver/insertion-window/FixedInsertionWindow.hpp"
 #include "flowshop-solver/problems/FSP.hpp"
 
 TEST(FSPInsertionStrategy, InsertBest) {  
   ASSERT_TRUE(1);
-}
\ No newline at end of file
+}
+
+TEST(InsertionWindow, FixedRange) {
+  FSP sol(10);
+  std::vector<int> positions;
+  FixedInsertionWindow<FSP> window(2);
+  window.candidates(sol, 1, positions);
+  ASSERT_EQ(positions, std::vector<int>({0, 1, 2, 3}));
+  window.candidates(sol, 9, positions);
+  ASSERT_EQ(positions, std::vector<int>({7, 8, 9}));
+}
+
+TEST(InsertionWindow, AdaptiveWidth) {
+  AdaptiveInsertionWindow<FSP> window(8, 1, 64, 10);
+  // improvements close to the job: shrink
+  for (int i = 0; i < 10; i++)
+    window.feedback(1, i % 2 == 0);
+  ASSERT_EQ(window.currentHalfWidth(), 2);
+  // improvements on the border: grow
+  for (int i = 0; i < 10; i++)
+    window.feedback(2, true);
+  ASSERT_EQ(window.currentHalfWidth(), 4);
+  // no improvements: grow
+  for (int i = 0; i < 10; i++)
+    window.feedback(0, false);
+  ASSERT_EQ(window.currentHalfWidth(), 8);
+}
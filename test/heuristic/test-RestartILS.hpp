@@ -0,0 +1,69 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <paradiseo/eo/eo>
+#include <paradiseo/mo/mo>
+
+#include "flowshop-solver/heuristics/RestartILS.hpp"
+#include "flowshop-solver/problems/FSP.hpp"
+
+namespace {
+
+/** Stops after `max` calls and counts how many times it was initialized. */
+struct CountingContinuator : public moContinuator<FSPNeighbor> {
+  int max, calls = 0, inits = 0;
+  explicit CountingContinuator(int max) : max{max} {}
+  void init(FSP&) override { inits++; }
+  auto operator()(FSP&) -> bool override { return ++calls < max; }
+};
+
+/** Explorer that never moves and stops after one step. */
+struct OneStepExplorer : public moNeighborhoodExplorer<FSPNeighbor> {
+  int initParams = 0;
+  void initParam(FSP&) override { initParams++; }
+  void updateParam(FSP&) override {}
+  auto isContinue(FSP&) -> bool override { return false; }
+  void move(FSP&) override {}
+  auto accept(FSP&) -> bool override { return false; }
+  void terminate(FSP&) override {}
+  void operator()(FSP&) override {}
+};
+
+/** Evaluates a permutation by its first job. */
+struct FirstJobEval : public eoEvalFunc<FSP> {
+  void operator()(FSP& sol) override { sol.fitness(sol[0]); }
+};
+
+/** Permutation starting with 5, 4, 3, ... on successive calls. */
+struct CountdownInit : public eoInit<FSP> {
+  int next = 5;
+  void operator()(FSP& sol) override {
+    sol.resize(6);
+    sol[0] = next--;
+  }
+};
+
+}  // namespace
+
+TEST(RestartILS, InitializesLocalSearchOnEveryRestart) {
+  OneStepExplorer explorer;
+  CountingContinuator localCheckpoint(100);
+  CountingContinuator globalCheckpoint(4);
+  FirstJobEval eval;
+  CountdownInit init;
+  moLocalSearch<FSPNeighbor> localSearch(explorer, localCheckpoint, eval);
+  RestartILS<FSPNeighbor> ils(localSearch, init, eval, globalCheckpoint);
+
+  FSP sol(6);
+  sol[0] = 6;
+  ils(sol);
+
+  ASSERT_EQ(3u, ils.restarts());
+  ASSERT_EQ(4, explorer.initParams);
+  ASSERT_EQ(4, localCheckpoint.inits);
+  ASSERT_EQ(1, globalCheckpoint.inits);
+  ASSERT_EQ(3, sol.fitness());
+  ASSERT_GE(ils.setupTime(), 0.0);
+  ASSERT_GE(ils.searchTime(), 0.0);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+#include "flowshop-solver/heuristics/JobPositionTabuList.hpp"
+#include "flowshop-solver/problems/FSP.hpp"
+
+TEST(JobPositionTabuList, MoveBackIsTabuForTenure) {
+  const int no_jobs = 6;
+  FSP sol(no_jobs);
+  std::iota(sol.begin(), sol.end(), 0);
+  JobPositionTabuList<FSPNeighbor> tabuList(2);
+  tabuList.init(sol);
+
+  FSPNeighbor move(1, 4, no_jobs);
+  ASSERT_FALSE(tabuList.check(sol, move));
+  move.move(sol);
+  tabuList.add(sol, move);
+  tabuList.update(sol, move);
+
+  // job 1 is now at position 4, moving it back to position 1 is tabu
+  FSPNeighbor moveBack(4, 1, no_jobs);
+  FSPNeighbor otherMove(4, 2, no_jobs);
+  ASSERT_TRUE(tabuList.check(sol, moveBack));
+  ASSERT_FALSE(tabuList.check(sol, otherMove));
+
+  tabuList.update(sol, moveBack);
+  ASSERT_TRUE(tabuList.check(sol, moveBack));
+  tabuList.update(sol, moveBack);
+  ASSERT_FALSE(tabuList.check(sol, moveBack));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
 
+#include "flowshop-solver/heuristics/CriticalBlockExplorer.hpp"
 #include "flowshop-solver/problems/FSPData.hpp"
 #include "flowshop-solver/problems/PermFSPEval.hpp"
 #include "flowshop-solver/problems/PermFSPNeighborMakespanEval.hpp"
@@ -65,4 +66,58 @@ TEST(PermFSP, NeighborCachedFlowtimeEvaluationSamples) {
       }
     }
   }
-}
\ No newline at end of file
+}
+TEST(PermFSP, CriticalBlocksLengthIsMakespan) {
+  const int no_jobs = 20;
+  const int no_machines = 10;
+  FSPData dt{no_jobs, no_machines};
+  PermFSPMakespanEval fullEval{dt};
+  PermFSPCompiler compiler{dt};
+  eoInitPermutation<FSP> init(no_jobs);
+  std::vector<int> ct;
+  std::vector<CriticalBlock> blocks;
+  for (int i = 0; i < 50; i++) {
+    FSP sol(no_jobs);
+    init(sol);
+    sol.resize(1 + rand() % no_jobs);
+    fullEval(sol);
+    compiler.compile(sol, ct);
+    compiler.criticalBlocks(sol, blocks);
+    ASSERT_EQ(blocks.front().first, 0);
+    ASSERT_EQ(blocks.front().machine, 0);
+    ASSERT_EQ(blocks.back().last, static_cast<int>(sol.size()) - 1);
+    ASSERT_EQ(blocks.back().machine, no_machines - 1);
+    int length = 0;
+    for (const auto& block : blocks)
+      for (int k = block.first; k <= block.last; k++)
+        length += dt.pt(sol[k], block.machine);
+    ASSERT_EQ(length, sol.fitness());
+  }
+}
+
+TEST(PermFSP, CriticalBlockExplorerImproves) {
+  rng.reseed(65465l);
+  const int no_jobs = 30;
+  const int no_machines = 10;
+  FSPData dt{no_jobs, no_machines, 100};
+  PermFSPMakespanEval fullEval{dt};
+  PermFSPNeighborMakespanEval neighborEval{dt};
+  moTrueContinuator<FSPNeighbor> tc;
+  NeigborhoodCheckpoint<FSPNeighbor> neighborhoodCheckpoint{tc};
+  moNeighborComparator<FSPNeighbor> compNN;
+  moSolNeighborComparator<FSPNeighbor> compSN;
+  CriticalBlockExplorer<FSP> explorer(dt, neighborEval, neighborhoodCheckpoint,
+                                      compNN, compSN);
+  moLocalSearch<FSPNeighbor> localSearch(explorer, tc, fullEval);
+
+  FSP sol(no_jobs);
+  eoInitPermutation<FSP> init(no_jobs);
+  init(sol);
+  fullEval(sol);
+  const auto initialFitness = sol.fitness();
+  localSearch(sol);
+  ASSERT_LE(sol.fitness(), initialFitness);
+  const auto fitness = sol.fitness();
+  fullEval(sol);
+  ASSERT_EQ(fitness, sol.fitness());
+}
@@ -3,9 +3,146 @@
 #include <paradiseo/mo/mo>
 #include <numeric>
 #include <random>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <gtest/gtest.h>
+
+#include "flowshop-solver/MHParamsSpecsFactory.hpp"
+#include "flowshop-solver/MHParamsValues.hpp"
+#include "flowshop-solver/heuristics/aco.hpp"
+#include "flowshop-solver/problems/FSP.hpp"
 #include "flowshop-solver/problems/FSPEval.hpp"
+#include "flowshop-solver/problems/FSPProblem.hpp"
+#include "flowshop-solver/problems/PermFSPEval.hpp"
+
+namespace {
+
+/** Evaporates and deposits on every trail, as MMAS did before lazy scaling. */
+void eagerUpdate(std::vector<double>& trails,
+                 const FSP& sol,
+                 double rho,
+                 double t_min,
+                 double t_max) {
+  const int N = sol.size();
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      double val = rho * trails[i * N + j];
+      if (sol[i] == j)
+        val += 1.0 / sol.fitness();
+      trails[i * N + j] = std::min(std::max(val, t_min), t_max);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(MinMaxAntSystem, LazyEvaporationMatchesEagerUpdate) {
+  rng.reseed(65465l);
+  const int N = 8;
+  const double t_min_f = 0.2;
+  for (const double rho : {0.3, 0.9}) {
+    MinMaxAntSystem<FSPNeighbor> mmas(N, t_min_f, rho, 0.5);
+    FSP sol(N);
+    std::iota(sol.begin(), sol.end(), 0);
+    sol.fitness(100);
+    mmas.init(sol);
+    const double t_max = 1.0 / ((1 - rho) * 100);
+    const double t_min = t_min_f * t_max;
+    std::vector<double> trails(N * N, t_max);
+
+    // enough updates for rho = 0.3 to rescale the stored values
+    FSPNeighbor neighbor;
+    for (int k = 0; k < 300; k++) {
+      std::shuffle(sol.begin(), sol.end(), std::mt19937(k));
+      // only a few positions keep receiving pheromone
+      std::sort(sol.begin(), sol.begin() + N / 2);
+      sol.fitness(100 + k % 7);
+      mmas.update(sol, neighbor);
+      eagerUpdate(trails, sol, rho, t_min, t_max);
+      for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+          ASSERT_NEAR(trails[i * N + j], mmas.pheromone(i, j),
+                      1e-12 * t_max);
+    }
+  }
+}
+
+TEST(Solve, ACOColony) {
+  const int N = 10;
+  const unsigned noAnts = 5;
+  MHParamsSpecs specs = MHParamsSpecsFactory::get("ACO");
+  std::unordered_map<std::string, std::string> values;
+  values["ACO.Comp.Strat"] = "0";
+  values["ACO.Init.Strat"] = "0";
+  values["ACO.Neighborhood.Size"] = "9.999";
+  values["ACO.Neighborhood.Strat"] = "0";
+  values["ACO.Local.Search"] = "0";
+  values["ACO.LS.Single.Step"] = "0";
+  values["ACO.T.Min.Factor"] = "0.2";
+  values["ACO.Rho"] = "0.7";
+  values["ACO.P0"] = "0.5";
+  values["ACO.Ants"] = std::to_string(noAnts);
+  values["ACO.Mode"] = "colony";
+  values["ACO.Update"] = "iteration_best";
+  for (const std::string threads : {"1", "2"}) {
+    RNG::seed(65465l);
+    FSPData dt(N, 5);
+    FSPProblem prob(dt, "PERM", "MAKESPAN", "low", "EVALS");
+    values["ACO.Threads"] = threads;
+    MHParamsValues params(&specs);
+    params.readValues(values);
+
+    const Result result = solveWithACOColony(prob, params);
+
+    FSP best = prob.bestSoFar().value();
+    std::vector<int> jobs(best.begin(), best.end());
+    std::sort(jobs.begin(), jobs.end());
+    std::vector<int> identity(N);
+    std::iota(identity.begin(), identity.end(), 0);
+    ASSERT_EQ(identity, jobs);
+    PermFSPMakespanEval eval(dt);
+    best.invalidate();
+    eval(best);
+    ASSERT_EQ(result.fitness, best.fitness());
+    // the last ants of a single thread evaluate at most one neighborhood
+    // each after the budget is spent
+    if (threads == "1")
+      ASSERT_LE(result.no_evals,
+                prob.getMaxEvals() + noAnts * (1 + (N - 1) * (N - 1)));
+  }
+}
+
+TEST(Solve, ACOIteratedLocalSearch) {
+  const int N = 10;
+  MHParamsSpecs specs = MHParamsSpecsFactory::get("ACO");
+  std::unordered_map<std::string, std::string> values;
+  values["ACO.Comp.Strat"] = "0";
+  values["ACO.Init.Strat"] = "0";
+  values["ACO.Neighborhood.Size"] = "9.999";
+  values["ACO.Neighborhood.Strat"] = "0";
+  values["ACO.Local.Search"] = "0";
+  values["ACO.LS.Single.Step"] = "0";
+  values["ACO.T.Min.Factor"] = "0.2";
+  values["ACO.Rho"] = "0.7";
+  values["ACO.P0"] = "0.5";
+  RNG::seed(65465l);
+  FSPData dt(N, 5);
+  FSPProblem prob(dt, "PERM", "MAKESPAN", "low", "EVALS");
+  MHParamsValues params(&specs);
+  params.readValues(values);
+
+  const Result result = solveWithACO(prob, params);
+
+  ASSERT_GT(result.fitness, 0);
+  ASSERT_GT(result.no_evals, 0);
+  FSP best = prob.bestSoFar().value();
+  PermFSPMakespanEval eval(dt);
+  best.invalidate();
+  eval(best);
+  ASSERT_EQ(result.fitness, best.fitness());
+}
 
 /*
 #include "flowshop-solver/eigen3/Eigen/Dense"
@@ -338,4 +475,8 @@ int main(int argc, char *argv[]) {
   return 0;
 }
 */
-int main(int, char *[]) { return 0; }
+auto main(int argc, char** argv) -> int {
+  MHParamsSpecsFactory::init(DATA_FOLDER "/specs");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
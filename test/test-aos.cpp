@@ -1,11 +1,24 @@
 #include <iostream>
+#include <algorithm>
 #include <array>
+#include <cstdio>
+#include <memory>
+#include <numeric>
 #include <random>
+#include <sstream>
+#include <thread>
 
 #include <gtest/gtest.h>
 
+#include "flowshop-solver/aos/EpsilonGreedy.hpp"
 #include "flowshop-solver/aos/adaptive_operator_selection.hpp"
+#include "flowshop-solver/aos/aos_state.hpp"
+#include "flowshop-solver/aos/aos_trace.hpp"
+#include "flowshop-solver/aos/gamma_sampler.hpp"
+#include "flowshop-solver/aos/operator_cost.hpp"
+#include "flowshop-solver/aos/sum_tree.hpp"
 #include "flowshop-solver/aos/probability_matching.hpp"
+#include "flowshop-solver/aos/shared_rewards.hpp"
 #include "flowshop-solver/aos/lin_ucb.hpp"
 #include "flowshop-solver/aos/frrmab.hpp"
 #include "flowshop-solver/aos/thompson_sampling.hpp"
@@ -85,8 +98,491 @@ TEST(AOSStaticDistributions, AOSTests)
 }
 
 
+TEST(AOSDataStructures, SumTreeFindsCumulativeWeights) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  std::vector<double> weights(37);
+  for (auto& w : weights)
+    w = weight(gen);
+  weights[5] = 0.0;
+  SumTree tree;
+  tree.assign(weights);
+  for (int step = 0; step < 200; step++) {
+    const int i = gen() % weights.size();
+    weights[i] = step % 7 == 0 ? 0.0 : weight(gen);
+    tree.set(i, weights[i]);
+    const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    ASSERT_NEAR(total, tree.total(), 1e-9);
+    const double target = weight(gen) * total;
+    int expected = 0;
+    double cumulative = weights[0];
+    while (cumulative <= target)
+      cumulative += weights[++expected];
+    ASSERT_EQ(expected, tree.find(target));
+  }
+}
+
+TEST(AOSManyArms, ProbabilityMatchingFavorsRewardedArm) {
+  std::vector<int> arms(500);
+  std::iota(arms.begin(), arms.end(), 0);
+  ProbabilityMatching<int> pm(arms, "avgabs", 0.3, 0.0005, 1);
+  int hits = 0;
+  for (int i = 0; i < 5000; i++) {
+    const int sel = pm.selectOperator();
+    if (i >= 4000 && sel == 123)
+      hits++;
+    pm.feedback(sel == 123 ? 1.0 : 0.0);
+    pm.update();
+  }
+  // uniform share is 500 * 0.0005 = 0.25
+  ASSERT_GT(hits, 600);
+}
+
+TEST(AOSManyArms, FRRMABFavorsRewardedArmWithLargeWindow) {
+  std::vector<int> arms(50);
+  std::iota(arms.begin(), arms.end(), 0);
+  FRRMAB<int> frrmab(arms, 1000, 0.1, 0.5);
+  int hits = 0;
+  for (int i = 0; i < 5000; i++) {
+    const int sel = frrmab.selectOperator();
+    if (i >= 4000 && sel == 13)
+      hits++;
+    frrmab.feedback(sel == 13 ? 1.0 : 0.0);
+    frrmab.update();
+  }
+  EXPECT_GT(hits, 800);
+}
+
+/** FRRMAB that recounts and sorts the whole window on every update. */
+class RecountedFRRMAB : public OperatorSelection<int> {
+  double scale, decay;
+  std::vector<std::pair<int, double>> window;
+  std::size_t next = 0;
+  double fir = 0.0;
+  int lastOp = -1, best = -1, noUnused;
+  std::vector<bool> unused;
+
+  auto selectOperatorIdx() -> int override {
+    if (noUnused > 0) {
+      lastOp = RNG::intUniform(0, noOperators() - 1);
+      if (unused[lastOp]) {
+        unused[lastOp] = false;
+        noUnused--;
+      }
+    } else {
+      lastOp = best;
+    }
+    return lastOp;
+  }
+
+ public:
+  RecountedFRRMAB(const std::vector<int>& arms,
+                  int windowSize,
+                  double scale,
+                  double decay)
+      : OperatorSelection<int>(arms),
+        scale{scale},
+        decay{decay},
+        window(windowSize, {-1, 0.0}),
+        noUnused{noOperators()},
+        unused(noOperators(), true) {}
+
+  void doFeedback(double feedback) override { fir += feedback; }
+
+  void update() override {
+    window[next] = {lastOp, fir};
+    next = (next + 1) % window.size();
+    lastOp = -1;
+    fir = 0.0;
+
+    std::vector<double> reward(noOperators(), 0.0);
+    std::vector<int> num(noOperators(), 0);
+    int total = 0;
+    for (const auto& [op, value] : window) {
+      if (op < 0)
+        continue;
+      reward[op] += value;
+      num[op]++;
+      total++;
+    }
+    std::vector<int> active;
+    for (int i = 0; i < noOperators(); i++)
+      if (num[i] > 0)
+        active.push_back(i);
+    std::sort(active.begin(), active.end(), [&](int a, int b) {
+      return reward[a] > reward[b] || (reward[a] == reward[b] && a < b);
+    });
+    const int noInactive = noOperators() - static_cast<int>(active.size());
+    std::vector<double> frr(noOperators(), 0.0);
+    double sum = 0.0;
+    for (int r = 0; r < static_cast<int>(active.size()); r++) {
+      const int i = active[r];
+      const int rank = r + 1 + (reward[i] < 0.0 ? noInactive : 0);
+      frr[i] = std::pow(decay, rank) * reward[i];
+      sum += frr[i];
+    }
+    best = -1;
+    double bestUcb = 0.0;
+    for (int i : active) {
+      if (sum > 0.0)
+        frr[i] /= sum;
+      const double ucb = frr[i] + scale * std::sqrt(2.0 * std::log(total) / num[i]);
+      if (best < 0 || ucb > bestUcb || (ucb == bestUcb && i < best)) {
+        best = i;
+        bestUcb = ucb;
+      }
+    }
+  }
+
+  auto printOn(std::ostream& os) -> std::ostream& override { return os; }
+};
+
+TEST(AOSManyArms, IncrementalFRRMABMatchesRecountedWindow) {
+  // dyadic rewards and decay keep both sums exact
+  const auto run = [](OperatorSelection<int>& aos, int noArms) {
+    RNG::seed(8624);
+    std::mt19937 gen(11);
+    std::vector<int> selections;
+    for (int step = 0; step < 20000; step++) {
+      const int sel = aos.selectOperator();
+      selections.push_back(sel);
+      const int noise = static_cast<int>(gen() % 9) - 3;
+      aos.feedback((noise + sel % 4 - (step / 5000) * (sel % 3)) * 0.25);
+      aos.update();
+      if (step % 7 == 0)
+        aos.update();
+    }
+    return selections;
+  };
+  for (const auto& [noArms, windowSize] :
+       {std::pair<int, int>{3, 20}, {10, 50}, {40, 500}}) {
+    std::vector<int> arms(noArms);
+    std::iota(arms.begin(), arms.end(), 0);
+    FRRMAB<int> incremental(arms, windowSize, 1.0, 0.5);
+    RecountedFRRMAB recounted(arms, windowSize, 1.0, 0.5);
+    ASSERT_EQ(run(recounted, noArms), run(incremental, noArms))
+        << noArms << " arms, window of " << windowSize;
+  }
+}
+
+TEST(AOSDataStructures, GammaSamplerMatchesMoments) {
+  std::mt19937_64 engine(42);
+  std::normal_distribution<double> normal;
+  for (double shape : {0.3, 1.0, 2.5, 40.0}) {
+    GammaSampler gamma(shape);
+    const int n = 200000;
+    double sum = 0.0, sumSq = 0.0;
+    for (int i = 0; i < n; i++) {
+      const double x = gamma(engine, normal);
+      ASSERT_GE(x, 0.0);
+      sum += x;
+      sumSq += x * x;
+    }
+    const double mean = sum / n;
+    // Gamma(a, 1) has mean and variance a
+    EXPECT_NEAR(shape, mean, 0.02 * shape + 0.01);
+    EXPECT_NEAR(shape, sumSq / n - mean * mean, 0.05 * shape + 0.01);
+  }
+  EXPECT_EQ(0.0, GammaSampler(0.0)(engine, normal));
+}
+
+class ConstantMetric : public FitnessLandscapeMetric {
+ public:
+  double value = 0.0;
+  int noComputes = 0;
+
+  auto compute() -> double override {
+    noComputes++;
+    return value;
+  }
+};
+
+TEST(AOSContextual, LinUCBLearnsContextDependentArm) {
+  ConstantMetric feature, bias;
+  bias.value = 1.0;
+  ProblemContext context;
+  context.add(feature);
+  context.add(bias);
+  LinUCB<int> linucb({0, 1}, context, 0.1);
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> uniform;
+  int correct = 0;
+  for (int i = 0; i < 2000; i++) {
+    feature.value = uniform(gen) < 0.5 ? 0.0 : 1.0;
+    linucb.update();
+    const int sel = linucb.selectOperator();
+    // arm 1 pays off in context 1 and arm 0 in context 0
+    const bool good = sel == static_cast<int>(feature.value);
+    if (i >= 1000)
+      correct += good;
+    linucb.feedback(good ? 1.0 : 0.0);
+  }
+  EXPECT_GT(correct, 950);
+  // the context is computed once per update
+  EXPECT_EQ(2000, feature.noComputes);
+}
+
+
 
 
+TEST(AOSShared, ConcurrentPushesAreAllRead) {
+  const int noWorkers = 4, noOps = 5, noPushes = 20000;
+  SharedOperatorRewards rewards(noOps, noWorkers);
+  std::vector<std::thread> workers;
+  for (int w = 0; w < noWorkers; w++) {
+    workers.emplace_back([&rewards, w]() {
+      const int id = rewards.addWorker();
+      for (int i = 0; i < noPushes; i++) {
+        rewards.push(id, i % noOps, i % 3 == 0 ? 1.0 : -0.5);
+        // totals read while being written are consistent
+        const auto totals = rewards.read((id + 1) % noWorkers, i % noOps);
+        ASSERT_LE(totals.positives, totals.count);
+      }
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+  long count = 0, positives = 0;
+  double sum = 0.0;
+  for (int w = 0; w < noWorkers; w++) {
+    for (int op = 0; op < noOps; op++) {
+      const auto totals = rewards.read(w, op);
+      count += totals.count;
+      positives += totals.positives;
+      sum += totals.sum;
+    }
+  }
+  const long noPositives = (noPushes + 2) / 3;
+  EXPECT_EQ(noWorkers * noPushes, count);
+  EXPECT_EQ(noWorkers * noPositives, positives);
+  EXPECT_DOUBLE_EQ(noWorkers * (noPositives - 0.5 * (noPushes - noPositives)),
+                   sum);
+}
+
+TEST(AOSShared, WorkersLearnFromEachOther) {
+  std::vector<int> arms(10);
+  std::iota(arms.begin(), arms.end(), 0);
+  SharedOperatorRewards rewards(arms.size(), 2);
+  ProbabilityMatching<int> rewarded(arms, "avgabs", 0.3, 0.01, 1);
+  ProbabilityMatching<int> unrewarded(arms, "avgabs", 0.3, 0.01, 1);
+  rewarded.share(rewards, 5);
+  unrewarded.share(rewards, 5);
+  int hits = 0;
+  for (int i = 0; i < 2000; i++) {
+    // only the first worker sees arm 3 paying off
+    rewarded.feedback(rewarded.selectOperator() == 3 ? 1.0 : 0.0);
+    rewarded.update();
+    const int sel = unrewarded.selectOperator();
+    if (i >= 1000 && sel == 3)
+      hits++;
+    unrewarded.feedback(0.0);
+    unrewarded.update();
+  }
+  EXPECT_GT(hits, 500);
+}
+
+TEST(AOSTrace, RoundTripFromSeveralThreads) {
+  const std::string filename = "test-aos-trace.bin";
+  const int noThreads = 3, noEvents = 5000;
+  {
+    AOSTraceWriter trace(filename, 1 << 16);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < noThreads; t++) {
+      threads.emplace_back([&trace, t]() {
+        for (int i = 0; i < noEvents; i++)
+          trace.record(t, i, -i);
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+  }
+  std::vector<int> next(noThreads, 0);
+  readAOSTrace(filename, [&](const AOSTraceEvent& event) {
+    ASSERT_GE(event.arm, 0);
+    // events of a thread keep their order
+    ASSERT_EQ(next[event.arm], event.reward);
+    ASSERT_EQ(-event.reward, event.fitness);
+    next[event.arm]++;
+  });
+  std::remove(filename.c_str());
+  EXPECT_EQ(std::vector<int>(noThreads, noEvents), next);
+}
+
+TEST(AOSTrace, FullBufferDropsEvents) {
+  const std::string filename = "test-aos-trace-full.bin";
+  long recorded = 0, dropped = 0;
+  {
+    AOSTraceWriter trace(filename, 4);
+    trace.fitness(10.0);
+    for (int i = 0; i < 100000; i++)
+      trace.record(i % 3, 1.0);
+  }
+  readAOSTrace(filename, [&](const AOSTraceEvent& event) {
+    if (event.arm < 0) {
+      dropped += event.reward;
+    } else {
+      recorded++;
+      EXPECT_EQ(10.0, event.fitness);
+    }
+  });
+  std::remove(filename.c_str());
+  EXPECT_EQ(100000, recorded + dropped);
+}
+
+TEST(AOSCost, RewardsImprovementPerEvaluation) {
+  struct CountingProblem {
+    unsigned long evals = 0;
+    [[nodiscard]] auto evalCount() const -> unsigned long { return evals; }
+  };
+  // arm 1 improves twice as much but costs ten times more evaluations
+  auto hitsOfCheapArm = [](bool chargeCost) {
+    CountingProblem problem;
+    EvaluationCost<CountingProblem> cost(problem);
+    ProbabilityMatching<int> pm({0, 1}, "avgabs", 0.3, 0.05, 1);
+    if (chargeCost)
+      pm.chargeCost(cost);
+    int hits = 0;
+    for (int i = 0; i < 2000; i++) {
+      const int sel = pm.selectOperator();
+      problem.evals += sel == 0 ? 10 : 100;
+      if (i >= 1000 && sel == 0)
+        hits++;
+      pm.feedback(sel == 0 ? 1.0 : 2.0);
+      pm.update();
+    }
+    return hits;
+  };
+  EXPECT_LT(hitsOfCheapArm(false), 500);
+  EXPECT_GT(hitsOfCheapArm(true), 500);
+}
+
+TEST(AOSState, RestoredSelectionsContinueFromSavedState) {
+  const std::string filename = "test-aos-state.txt";
+  std::vector<int> arms(5);
+  std::iota(arms.begin(), arms.end(), 0);
+  ConstantMetric feature;
+  ProblemContext context;
+  context.add(feature);
+  auto build = [&]() {
+    std::vector<std::unique_ptr<OperatorSelection<int>>> aoss;
+    aoss.emplace_back(new ProbabilityMatching<int>(arms, "avgabs", 0.3, 0.05, 1));
+    aoss.emplace_back(new FRRMAB<int>(arms, 20, 1.0, 0.5));
+    aoss.emplace_back(new ThompsonSampling<int>(arms));
+    aoss.emplace_back(new DynamicThompsonSampling<int>(arms, 10));
+    aoss.emplace_back(new EpsilonGreedy<int>(arms, 0.1));
+    aoss.emplace_back(new LinUCB<int>(arms, context, 0.1));
+    return aoss;
+  };
+  auto stateOf = [](const OperatorSelection<int>& aos) {
+    std::ostringstream os;
+    os.precision(std::numeric_limits<double>::max_digits10);
+    aos.saveState(os);
+    return os.str();
+  };
+
+  auto trained = build();
+  std::vector<std::string> states;
+  {
+    AOSStateStore store(filename);
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> uniform;
+    for (unsigned i = 0; i < trained.size(); i++) {
+      auto& aos = *trained[i];
+      for (int step = 0; step < 300; step++) {
+        feature.value = uniform(gen);
+        aos.update();
+        const int sel = aos.selectOperator();
+        aos.feedback(uniform(gen) < sel / 5.0 ? 1.0 : 0.0);
+      }
+      store.track("key" + std::to_string(i), aos);
+      states.push_back(stateOf(aos));
+    }
+    store.save();
+  }
+
+  AOSStateStore store(filename);
+  auto restored = build();
+  for (unsigned i = 0; i < restored.size(); i++) {
+    ASSERT_TRUE(store.restore("key" + std::to_string(i), *restored[i]));
+    EXPECT_EQ(states[i], stateOf(*restored[i]));
+  }
+  ProbabilityMatching<int> moreArms({0, 1, 2, 3, 4, 5});
+  EXPECT_FALSE(store.restore("key0", moreArms));
+  EXPECT_FALSE(store.restore("unknown", *restored[0]));
+  std::remove(filename.c_str());
+  std::remove((filename + ".lock").c_str());
+}
+
+TEST(AOSDataStructures, ThompsonSamplingResetRestoresPrior) {
+  RNG::seed(77);
+  ThompsonSampling<int> ts({0, 1, 2});
+  for (int i = 0; i < 50; i++) {
+    ts.selectOperator();
+    ts.feedback(1.0);
+  }
+  ts.reset(0.0);
+  // the uniform prior selects every arm about as often
+  std::array<int, 3> counts{};
+  for (int i = 0; i < 600; i++)
+    counts[ts.selectOperator()]++;
+  for (int count : counts)
+    EXPECT_GT(count, 100);
+}
+
+TEST(AOSState, SavesOfRunsSharingAFileAreMerged) {
+  const std::string filename = "test-aos-shared-state.txt";
+  std::remove(filename.c_str());
+  ThompsonSampling<int> first({0, 1, 2});
+  ThompsonSampling<int> second({0, 1, 2});
+  for (int i = 0; i < 10; i++) {
+    first.selectOperator();
+    first.feedback(1.0);
+  }
+  AOSStateStore firstStore(filename);
+  AOSStateStore secondStore(filename);
+  firstStore.track("first", first);
+  secondStore.track("second", second);
+  firstStore.save();
+  secondStore.save();
+
+  AOSStateStore merged(filename);
+  ThompsonSampling<int> restored({0, 1, 2});
+  EXPECT_TRUE(merged.restore("first", restored));
+  EXPECT_TRUE(merged.restore("second", restored));
+  std::remove(filename.c_str());
+  std::remove((filename + ".lock").c_str());
+}
+
+TEST(AOSState, ReleasedSelectionsAreSavedAfterTheirOwnerDies) {
+  const std::string filename = "test-aos-released-state.txt";
+  auto stateOf = [](const OperatorSelection<int>& aos) {
+    std::ostringstream os;
+    os.precision(std::numeric_limits<double>::max_digits10);
+    aos.saveState(os);
+    return os.str();
+  };
+  std::string state;
+  AOSStateStore store(filename);
+  {
+    const int owner = 0;
+    ThompsonSampling<int> owned({0, 1, 2});
+    for (int i = 0; i < 20; i++) {
+      owned.selectOperator();
+      owned.feedback(1.0);
+    }
+    store.track("owned", owned, &owner);
+    store.release(&owner);
+    state = stateOf(owned);
+  }
+  store.save();
+
+  AOSStateStore saved(filename);
+  ThompsonSampling<int> restored({0, 1, 2});
+  ASSERT_TRUE(saved.restore("owned", restored));
+  EXPECT_EQ(state, stateOf(restored));
+  std::remove(filename.c_str());
+  std::remove((filename + ".lock").c_str());
+}
 
 auto main(int argc, char **argv) -> int
 {
@@ -1,5 +1,19 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flowshop-solver/fla/AutocorrelationFLA.hpp"
+#include "flowshop-solver/fla/FitnessDistanceCorrelationFLA.hpp"
+#include "flowshop-solver/fla/FitnessFile.hpp"
+#include "flowshop-solver/fla/PermutationEnumerator.hpp"
 #include "flowshop-solver/fla/SnowballLONSampling.hpp"
 #include "flowshop-solver/fla_methods.hpp"
 
@@ -41,6 +55,86 @@ TEST(SamplingLON, CanSampleLON) {
  // sampleLON(prob, sampling_params, 123l);
 }
 
+TEST(PermutationEnumerator, MatchesFullEnumeration) {
+  rng.reseed(65465l);
+  const int no_jobs = 7;
+  FSPData dt(no_jobs, 4, 20);
+  for (const std::string type : {"PERM", "NOWAIT"}) {
+    for (const std::string objective : {"MAKESPAN", "FLOWTIME"}) {
+      FSPProblem problem(dt, type, objective, "med", "EVALS");
+      std::map<long, unsigned long> expected;
+      FSP sol(no_jobs);
+      std::iota(sol.begin(), sol.end(), 0);
+      do {
+        sol.invalidate();
+        problem.eval()(sol);
+        expected[static_cast<long>(sol.fitness())]++;
+      } while (std::next_permutation(sol.begin(), sol.end()));
+
+      for (unsigned noThreads : {1u, 3u}) {
+        FitnessHistogram histogram;
+        PermutationEnumerator enumerator(problem, 100);
+        ASSERT_EQ(5040ul, enumerator.run(histogram, noThreads));
+        ASSERT_EQ(expected, histogram.counts());
+      }
+    }
+  }
+}
+
+TEST(PermutationEnumerator, FitnessFileRoundTrip) {
+  const std::string filename = "test-fitness-file.bin";
+  const std::vector<long> values = {120, 118, 118, 125, 0, -3, 70000};
+  {
+    FitnessFileWriter writer(filename);
+    writer({values.begin(), values.begin() + 3});
+    writer({values.begin() + 3, values.end()});
+  }
+  std::vector<long> read;
+  readFitnessFile(filename, [&](long value) { read.push_back(value); });
+  std::remove(filename.c_str());
+  ASSERT_EQ(values, read);
+}
+
+TEST(FitnessHistory, StreamingMetricsMatchFullHistory) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> fitness(5000, 6000);
+  FitnessHistory<FSP> history;
+  AutocorrelationFLA<FSP> autocorr1(history, 1);
+  AutocorrelationFLA<FSP> autocorr3(history, 3);
+  const std::vector<std::pair<int, AutocorrelationFLA<FSP>*>> autocorrs = {
+      {1, &autocorr1}, {3, &autocorr3}};
+  FitnessDistanceCorrelationFLA<FSP> fdc(history);
+  std::vector<double> values;
+  for (int step = 0; step < 300; step++) {
+    values.push_back(fitness(gen) - step);
+    history.push(values.back());
+    const int n = values.size();
+    const double mean = std::accumulate(values.begin(), values.end(), 0.0) / n;
+    double var = 0.0;
+    for (double x : values)
+      var += (x - mean) * (x - mean);
+    var = n > 1 ? var / (n - 1) : 0.0;
+    ASSERT_NEAR(mean, history.mean(), 1e-6);
+    ASSERT_NEAR(var, history.variance(), 1e-6 * var + 1e-9);
+    if (n == 1)
+      continue;
+    for (const auto& [delay, metric] : autocorrs) {
+      double sum = 0.0;
+      for (int i = 0; i < n - delay; i++)
+        sum += (values[i] - mean) * (values[i + delay] - mean);
+      const double expected = sum / std::max((n - delay) * var, 1e-6);
+      ASSERT_NEAR(expected, metric->compute(), 1e-9);
+    }
+    double sum = 0.0;
+    for (int i = 0; i < n - 1; i++)
+      sum += (values[i] - mean) * (n - i - n / 2.0);
+    const double sdDist = std::sqrt((n - 1) * (n + 1) / 12.0);
+    const double expected =
+        sum / std::max((n - 1) * std::sqrt(var) * sdDist, 1e-6);
+    ASSERT_NEAR(expected, fdc.compute(), 1e-9);
+  }
+}
+
 auto main(int argc, char **argv) -> int {
   argc = 2;
   // char* argvv[] = {"", "--gtest_filter=FLA.*"};
@@ -313,6 +313,43 @@ TEST(TaillardAcceleration, RecompileNeighbor) {
   ASSERT_EQ(ng.fitness(), sol2.fitness());
 }
 
+#include "flowshop-solver/heuristics/perturb/PartialSolutionLocalSearch.hpp"
+
+TEST(TaillardAcceleration, PartialInsertionLocalSearch) {
+  rng.reseed(65465l);
+  const int no_jobs = 30;
+  const int no_machines = 10;
+  FSPData fspData(no_jobs, no_machines, 100);
+
+  FSP sol(no_jobs);
+  eoInitPermutation<FSP> randomInit(no_jobs);
+  randomInit(sol);
+  sol.resize(no_jobs - 8);
+  FSP sol2 = sol;
+
+  PermFSPMakespanEval fullEval(fspData);
+  PermFSPNeighborMakespanEval ne(fspData);
+  moFullEvalByCopy<FSPNeighbor> fullNe(fullEval);
+  moTrueContinuator<FSPNeighbor> tc;
+  moNeighborComparator<FSPNeighbor> compNN;
+  moSolNeighborComparator<FSPNeighbor> compSN;
+
+  PartialInsertionLocalSearch<FSPNeighbor> ls(ne, compNN, compSN, tc);
+  PartialInsertionLocalSearch<FSPNeighbor> lsFull(fullNe, compNN, compSN, tc);
+
+  rng.reseed(65465l);
+  const bool changed = ls(sol);
+  rng.reseed(65465l);
+  lsFull(sol2);
+
+  ASSERT_TRUE(changed);
+  ASSERT_EQ(sol, sol2);
+  const auto fitness = sol.fitness();
+  fullEval(sol);
+  ASSERT_EQ(fitness, sol.fitness());
+  ASSERT_FALSE(ls(sol));
+}
+
 #include "flowshop-solver/heuristics/FSPOrderHeuristics.hpp"
 
 
@@ -328,6 +365,12 @@ TEST(TaillardAcceleration, RecompileNeighbor) {
 #include "heuristic/test-NEH.hpp"
 #include "heuristic/test-IG.hpp"
 #include "heuristic/test-PositionSelector.hpp"
+#include "heuristic/test-TabuList.hpp"
+#include "heuristic/test-FastSA.hpp"
+#include "heuristic/test-RestartILS.hpp"
+#include "heuristic/test-Crossover.hpp"
+#include "heuristic/test-BranchAndBound.hpp"
+#include "heuristic/test-BeamSearch.hpp"
 
 // TEST(AllFSP, ScheduleInfo) {
 //   std::vector<int> pts = { //
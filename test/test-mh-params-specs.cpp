@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <sstream>
+
 #include "flowshop-solver/MHParamsSpecs.hpp"
+#include "flowshop-solver/ParamsPolicy.hpp"
+#include "flowshop-solver/problems/FSPData.hpp"
+#include "flowshop-solver/problems/FSPInstanceFeatures.hpp"
 
 TEST(ParamSpec, EqualOperator) {
   ParamSpec paramA("param1", ParamSpec::Type::CAT, 1.1, 2);
@@ -29,10 +35,48 @@ TEST(ParamSpec, NumericalValueFromStr) {
   ASSERT_FLOAT_EQ(numparam.fromStrValue("2.5"), 2.5f);
 }
 
+TEST(ParamsPolicy, PredictsLeafAndKeepsGivenValues) {
+  std::istringstream tree(
+      "# policy tree\n"
+      "split no_jobs < 50\n"
+      "leaf IG.Destruction.Size=2 IG.AOS.Strategy=probability_matching\n"
+      "split pt_sd >= 25.5\n"
+      "leaf IG.Destruction.Size=4\n"
+      "\n"
+      "leaf IG.Destruction.Size=8 IG.AOS.Strategy=frrmab\n");
+  ParamsPolicy policy(tree);
+  ASSERT_EQ(policy.predict({{"no_jobs", 20}, {"pt_sd", 30}}).size(), 2u);
+  ASSERT_EQ(policy.predict({{"no_jobs", 100}, {"pt_sd", 30}})[0].second, "4");
+  std::unordered_map<std::string, std::string> params = {
+      {"IG.AOS.Strategy", "thompson_sampling"}};
+  policy.apply({{"no_jobs", 100}, {"pt_sd", 10}}, params);
+  ASSERT_EQ(params["IG.Destruction.Size"], "8");
+  ASSERT_EQ(params["IG.AOS.Strategy"], "thompson_sampling");
+  ASSERT_THROW((void)policy.predict({{"no_jobs", 100}}), std::runtime_error);
+}
+
+TEST(InstanceFeatures, MomentsOfSmallInstance) {
+  // jobs (1, 2), (3, 4) and (5, 9) on two machines
+  const auto features = instanceFeatures(FSPData({1, 2, 3, 4, 5, 9}, 3));
+  ASSERT_EQ(features.at("no_jobs"), 3.0);
+  ASSERT_EQ(features.at("no_machines"), 2.0);
+  ASSERT_DOUBLE_EQ(features.at("pt_sd"), std::sqrt(8.0));
+  // machines: (1, 3, 5) and (2, 4, 9)
+  ASSERT_DOUBLE_EQ(features.at("mean_sd_per_machine"),
+                   (2.0 + std::sqrt(13.0)) / 2);
+  ASSERT_DOUBLE_EQ(features.at("mean_skew_per_machine"),
+                   12.0 / std::pow(26.0 / 3, 1.5) / 2);
+  ASSERT_DOUBLE_EQ(features.at("mean_kurt_per_machine"), -1.5);
+  ASSERT_DOUBLE_EQ(features.at("mean_sd_per_job"),
+                   (2 * std::sqrt(0.5) + std::sqrt(8.0)) / 3);
+  ASSERT_DOUBLE_EQ(features.at("mean_skew_per_job"), 0.0);
+  ASSERT_DOUBLE_EQ(features.at("mean_kurt_per_job"), -2.0);
+}
+
 auto main(int argc, char **argv) -> int {
   argc = 2;
   // char* argvv[] = {"", "--gtest_filter=FLA.*"};
   // testing::InitGoogleTest(&argc, argvv);
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}